@@ -0,0 +1,103 @@
+include("${CMAKE_CURRENT_LIST_DIR}/../tests/native.cmake")
+
+find_native_toolchain("${WORK_DIR}" reason)
+
+if(reason)
+    message("${reason}, skipping benchmark")
+    return()
+endif()
+
+if(NOT RUNS)
+    set(RUNS 20)
+endif()
+
+function(count_instructions assembly instructions)
+    file(STRINGS "${assembly}" lines)
+    set(inText FALSE)
+    set(count 0)
+
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^section ([^ \t]+)")
+            string(REGEX MATCH "^\\.text" inText "${CMAKE_MATCH_1}")
+        elseif(line MATCHES "^\t\\.section\t([^,]+)")
+            string(REGEX MATCH "^\\.text" inText "${CMAKE_MATCH_1}")
+        elseif(line MATCHES "^\t\\.(text|data|bss)$")
+            string(COMPARE EQUAL "${CMAKE_MATCH_1}" "text" inText)
+        elseif(inText AND line MATCHES "^\t[a-z]" AND NOT line MATCHES "^\t(extern|global|align) ")
+            math(EXPR count "${count} + 1")
+        endif()
+    endforeach()
+
+    set(${instructions} ${count} PARENT_SCOPE)
+endfunction()
+
+file(GLOB KERNELS "${CORPUS}/*.c")
+list(SORT KERNELS)
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+set(json "{\n  \"runs\": ${RUNS},\n  \"reference\": \"${CC}\",\n  \"kernels\": [")
+set(kernelSeparator "")
+
+foreach(kernel ${KERNELS})
+    get_filename_component(name "${kernel}" NAME_WE)
+    string(APPEND json "${kernelSeparator}\n    {\n      \"name\": \"${name}\",\n      \"levels\": [")
+    set(kernelSeparator ",")
+    set(levelSeparator "")
+
+    foreach(level 0 1 2)
+        set(assembly "${WORK_DIR}/${name}-O${level}.s")
+        set(executable "${WORK_DIR}/${name}-O${level}")
+
+        compile_boltc("${kernel}" "${assembly}" -O${level})
+        link_native("${assembly}" "${executable}")
+        time_native("${executable}" "${WORK_DIR}" ${RUNS} microseconds)
+        count_instructions("${assembly}" instructions)
+        file(SIZE "${assembly}" assemblyBytes)
+        file(SIZE "${assembly}.o" objectBytes)
+
+        string(APPEND json "${levelSeparator}\n        {\"level\": ${level}, \"instructions\": ${instructions}, "
+                           "\"assemblyBytes\": ${assemblyBytes}, \"objectBytes\": ${objectBytes}, "
+                           "\"microseconds\": ${microseconds}}")
+        set(levelSeparator ",")
+    endforeach()
+
+    string(APPEND json "\n      ],\n      \"reference\": [")
+    set(levelSeparator "")
+
+    foreach(level 0 2)
+        set(assembly "${WORK_DIR}/${name}-cc-O${level}.s")
+        set(object "${WORK_DIR}/${name}-cc-O${level}.o")
+        set(executable "${WORK_DIR}/${name}-cc-O${level}")
+
+        execute_process(COMMAND "${CC}" -m32 -O${level} -S -masm=intel "${kernel}" -o "${assembly}"
+                        RESULT_VARIABLE result OUTPUT_QUIET ERROR_VARIABLE error)
+
+        if(result EQUAL 0)
+            execute_process(COMMAND "${CC}" -m32 -O${level} -c "${kernel}" -o "${object}"
+                            RESULT_VARIABLE result OUTPUT_QUIET ERROR_VARIABLE error)
+        endif()
+
+        if(result EQUAL 0)
+            execute_process(COMMAND "${CC}" -m32 -no-pie "${object}" -o "${executable}"
+                            RESULT_VARIABLE result OUTPUT_QUIET ERROR_VARIABLE error)
+        endif()
+
+        if(NOT result EQUAL 0)
+            message(FATAL_ERROR "${CC} failed on ${name} at -O${level}: ${error}")
+        endif()
+
+        time_native("${executable}" "${WORK_DIR}" ${RUNS} microseconds)
+        count_instructions("${assembly}" instructions)
+        file(SIZE "${object}" objectBytes)
+
+        string(APPEND json "${levelSeparator}\n        {\"level\": ${level}, \"instructions\": ${instructions}, "
+                           "\"objectBytes\": ${objectBytes}, \"microseconds\": ${microseconds}}")
+        set(levelSeparator ",")
+    endforeach()
+
+    string(APPEND json "\n      ]\n    }")
+endforeach()
+
+string(APPEND json "\n  ]\n}\n")
+file(WRITE "${OUTPUT}" "${json}")
+message("Benchmark results written to ${OUTPUT}")
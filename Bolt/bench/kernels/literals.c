@@ -0,0 +1,17 @@
+int main()
+{
+    0;
+    42;
+    4294967295u;
+    9223372036854775807ll;
+    0x7FFFFFFF;
+    0b101010;
+    0777;
+    1.5f;
+    2.25;
+    0x1.8p1;
+    1e300;
+    "benchmark";
+    1.5f;
+    2.25;
+}
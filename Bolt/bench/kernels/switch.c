@@ -0,0 +1,24 @@
+int dense()
+{
+    switch (3) { case 0: 10; break; case 1: 11; break; case 2: 12; break; case 3: 13; break; case 4: 14; break; case 5: 15; break; case 6: 16; break; default: 17; }
+}
+
+int sparse()
+{
+    switch (70000) { case 1: 1; break; case 100: 2; break; case 1000: 3; break; case 10000: 4; break; case 70000: 5; break; case 100000: 6; break; case 700000: 7; break; }
+}
+
+int fallthrough()
+{
+    switch (2) { case 1: 1; case 2: 2; case 3: 3; break; default: 4; }
+}
+
+int wide()
+{
+    switch (4294967296ll) { case 4294967296ll: 1; break; case -1: 2; break; case 7: 3; break; }
+}
+
+int main()
+{
+    switch (1) { case 0: 0; break; case 1: switch (-2) { case -2: 1; break; case -1: 2; break; default: 3; } break; default: 4; }
+}
@@ -0,0 +1,15 @@
+int main()
+{
+    -1;
+    !0;
+    - -7;
+    !!42;
+    -(-(-(-(-(-(-(-9)))))));
+    -4294967296ll;
+    !4294967296ll;
+    -1.5f;
+    -2.25;
+    !0.0;
+    !-0.5f;
+    -(-(-3.75));
+}
@@ -0,0 +1,243 @@
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <protocol.h>
+
+static int writeExact(int fd, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    while (size > 0)
+    {
+        ssize_t count = write(fd, bytes, size);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count <= 0)
+        {
+            return 0;
+        }
+
+        bytes += count;
+        size -= (size_t)count;
+    }
+
+    return 1;
+}
+
+static int readExact(int fd, void *data, size_t size)
+{
+    uint8_t *bytes = (uint8_t *)data;
+
+    while (size > 0)
+    {
+        ssize_t count = read(fd, bytes, size);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count <= 0)
+        {
+            return 0;
+        }
+
+        bytes += count;
+        size -= (size_t)count;
+    }
+
+    return 1;
+}
+
+static char *readStream(FILE *file, size_t *length)
+{
+    size_t capacity = 4096;
+    size_t count = 0;
+    char *buffer = malloc(capacity);
+
+    while (buffer != NULL)
+    {
+        count += fread(buffer + count, 1, capacity - count, file);
+
+        if (count < capacity)
+        {
+            break;
+        }
+
+        capacity *= 2;
+        char *grown = realloc(buffer, capacity);
+
+        if (grown == NULL)
+        {
+            free(buffer);
+            return NULL;
+        }
+
+        buffer = grown;
+    }
+
+    *length = count;
+    return buffer;
+}
+
+int main(int argc, char **argv)
+{
+    const char *socketPath = getenv("BOLTC_SERVER_SOCKET");
+    const char *inputPath = NULL;
+    const char *outputPath = NULL;
+    uint32_t threadCount = 1;
+    uint32_t level = 0;
+    uint32_t flags = COMPILE_REQUEST_FLAG_NONE;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc)
+        {
+            socketPath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--threads") == 0 || strcmp(argv[i], "--workers") == 0) && i + 1 < argc)
+        {
+            threadCount = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--hash-cons") == 0)
+        {
+            flags |= COMPILE_REQUEST_FLAG_HASH_CONS;
+        }
+        else if (strcmp(argv[i], "--lazy-bodies") == 0)
+        {
+            flags |= COMPILE_REQUEST_FLAG_LAZY_BODIES;
+        }
+        else if (strncmp(argv[i], "-O", 2) == 0 && argv[i][2] >= '0' && argv[i][2] <= '9' && argv[i][3] == '\0')
+        {
+            level = (uint32_t)(argv[i][2] - '0');
+        }
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            outputPath = argv[++i];
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            fprintf(stderr, "Error: Unsupported option '%s'.\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        else if (inputPath != NULL)
+        {
+            fprintf(stderr, "Error: Multiple inputs '%s' and '%s'.\n", inputPath, argv[i]);
+            return EXIT_FAILURE;
+        }
+        else
+        {
+            inputPath = argv[i];
+        }
+    }
+
+    if (inputPath == NULL)
+    {
+        fprintf(stderr, "Usage: %s [--socket path] [--threads count] [-O<level>] [--hash-cons] [--lazy-bodies] "
+                        "<input | -> [-o output]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (socketPath == NULL)
+    {
+        socketPath = COMPILE_SERVER_DEFAULT_SOCKET;
+    }
+
+    CompileRequestHeader request;
+    request.magic = COMPILE_SERVER_MAGIC;
+    request.threadCount = threadCount;
+    request.level = level;
+    request.flags = flags;
+
+    char *payload;
+    size_t length;
+
+    if (strcmp(inputPath, "-") == 0)
+    {
+        request.kind = COMPILE_REQUEST_INLINE_SOURCE;
+        payload = readStream(stdin, &length);
+    }
+    else
+    {
+        char resolved[PATH_MAX];
+        request.kind = COMPILE_REQUEST_SOURCE_PATH;
+        payload = strdup(realpath(inputPath, resolved) != NULL ? resolved : inputPath);
+        length = payload != NULL ? strlen(payload) : 0;
+    }
+
+    if (payload == NULL || length > COMPILE_SERVER_MAX_PAYLOAD)
+    {
+        fprintf(stderr, "Error: Could not read input '%s'.\n", inputPath);
+        return EXIT_FAILURE;
+    }
+
+    request.length = (uint32_t)length;
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (connection < 0 || connect(connection, (struct sockaddr *)&address, sizeof(address)) < 0)
+    {
+        fprintf(stderr, "Error: Could not connect to compile server at '%s'.\n", socketPath);
+        return EXIT_FAILURE;
+    }
+
+    CompileResponseHeader response;
+
+    if (!writeExact(connection, &request, sizeof(request)) || !writeExact(connection, payload, length) ||
+        !readExact(connection, &response, sizeof(response)) || response.magic != COMPILE_SERVER_MAGIC)
+    {
+        fprintf(stderr, "Error: Compile server closed the connection.\n");
+        return EXIT_FAILURE;
+    }
+
+    char *result = malloc((size_t)response.length + 1);
+
+    if (result == NULL || !readExact(connection, result, response.length))
+    {
+        fprintf(stderr, "Error: Compile server closed the connection.\n");
+        return EXIT_FAILURE;
+    }
+
+    close(connection);
+    free(payload);
+
+    if (response.status != 0)
+    {
+        fprintf(stderr, "%.*s\n", (int)response.length, result);
+        return EXIT_FAILURE;
+    }
+
+    FILE *output = outputPath != NULL ? fopen(outputPath, "w") : stdout;
+
+    if (output == NULL || fwrite(result, 1, response.length, output) != response.length)
+    {
+        fprintf(stderr, "Error: Could not write output file '%s'.\n", outputPath);
+        return EXIT_FAILURE;
+    }
+
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+
+    free(result);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+#include <arena.h>
+#include <memory.h>
+
+static size_t alignArenaSize(size_t size)
+{
+    return (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+static void freeArenaBlocks(ArenaBlock *block)
+{
+    while (block != NULL)
+    {
+        ArenaBlock *next = block->next;
+        FREE(block);
+        block = next;
+    }
+}
+
+static ArenaBlock *newArenaBlock(size_t size)
+{
+    size_t headerSize = alignArenaSize(sizeof(ArenaBlock));
+    ArenaBlock *block = (ArenaBlock *)allocate(headerSize + size);
+
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->size = headerSize + size;
+    block->used = headerSize;
+
+    return block;
+}
+
+void initArena(Arena *arena, size_t blockSize)
+{
+    arena->blocks = NULL;
+    arena->spare = NULL;
+    arena->blockSize = blockSize;
+}
+
+void *arenaAllocate(Arena *arena, size_t size)
+{
+    size = alignArenaSize(size);
+    ArenaBlock *block = arena->blocks;
+
+    if (block == NULL || block->size - block->used < size)
+    {
+        size_t blockSize = size > arena->blockSize ? size : arena->blockSize;
+        ArenaBlock *newBlock = arena->spare;
+
+        if (newBlock != NULL && size <= arena->blockSize)
+        {
+            arena->spare = newBlock->next;
+            newBlock->used = alignArenaSize(sizeof(ArenaBlock));
+        }
+        else
+        {
+            newBlock = newArenaBlock(blockSize);
+        }
+
+        if (newBlock == NULL)
+        {
+            return NULL;
+        }
+
+        if (block != NULL && size > arena->blockSize)
+        {
+            newBlock->next = block->next;
+            block->next = newBlock;
+        }
+        else
+        {
+            newBlock->next = block;
+            arena->blocks = newBlock;
+        }
+
+        block = newBlock;
+    }
+
+    void *ptr = (uint8_t *)block + block->used;
+    block->used += size;
+
+    return ptr;
+}
+
+void mergeArena(Arena *arena, Arena *other)
+{
+    if (other->blocks == NULL)
+    {
+        return;
+    }
+
+    ArenaBlock *last = other->blocks;
+
+    while (last->next != NULL)
+    {
+        last = last->next;
+    }
+
+    if (arena->blocks == NULL)
+    {
+        arena->blocks = other->blocks;
+    }
+    else
+    {
+        last->next = arena->blocks->next;
+        arena->blocks->next = other->blocks;
+    }
+
+    other->blocks = NULL;
+}
+
+void resetArena(Arena *arena)
+{
+    size_t standardSize = alignArenaSize(sizeof(ArenaBlock)) + arena->blockSize;
+    ArenaBlock *block = arena->blocks;
+
+    while (block != NULL)
+    {
+        ArenaBlock *next = block->next;
+
+        if (block->size == standardSize)
+        {
+            block->next = arena->spare;
+            arena->spare = block;
+        }
+        else
+        {
+            FREE(block);
+        }
+
+        block = next;
+    }
+
+    arena->blocks = NULL;
+}
+
+void freeArena(Arena *arena)
+{
+    freeArenaBlocks(arena->blocks);
+    freeArenaBlocks(arena->spare);
+    arena->blocks = NULL;
+    arena->spare = NULL;
+}
@@ -2,21 +2,164 @@
 #define ASSEMBER_H
 
 #include <parsing.h>
+#include <walker.h>
+#include <selection.h>
+#include <profile.h>
+#include <array.h>
+#include <hashmap.h>
 #include <stdio.h>
 
+#define PARALLEL_EMIT_MIN_TREES 1024
+#define PARALLEL_EMIT_UNITS_PER_THREAD 4
+#define SWITCH_TABLE_DISPATCH_COST 4
+#define SWITCH_TABLE_HOLES_PER_COMPARE 8
+#define SWITCH_TABLE_MAX_ENTRIES 4096
+#define SWITCH_SEARCH_LEAF_CASES 3
+#define SWITCH_SEARCH_MAX_DEPTH 64
+#define SWITCH_HOT_COUNTER_NONE UINT32_MAX
+#define ASSEMBLY_LITERAL_POOL_MIN_SLOTS 16
+
+typedef enum
+{
+    ASSEMBLY_CONSTANT_NONE = 0,
+    ASSEMBLY_CONSTANT_FLOAT_SIGN_MASK = 1 << 0,
+    ASSEMBLY_CONSTANT_DOUBLE_SIGN_MASK = 1 << 1,
+} AssemblyConstant;
+
+typedef enum
+{
+    SWITCH_LOWERING_LINEAR,
+    SWITCH_LOWERING_BINARY_SEARCH,
+    SWITCH_LOWERING_JUMP_TABLE,
+} SwitchLowering;
+
+typedef struct
+{
+    size_t count;
+    size_t capacity;
+    char *data;
+} AssemblyBuffer;
+
+typedef struct
+{
+    uint64_t bits;
+    uint32_t width;
+} AssemblyLiteral;
+
+DECLARE_ARRAY(AssemblyLiteralArray, AssemblyLiteral, literals);
+
+typedef struct
+{
+    HashMap slots;
+    AssemblyLiteralArray literals;
+} AssemblyLiteralPool;
+
+typedef struct
+{
+    AstSwitchStatement *statement;
+    size_t label;
+    bool dispatched;
+    uint32_t firstCounter;
+    uint32_t hotCounter;
+    bool hotReached;
+    bool terminated;
+    bool cold;
+} AssemblySwitch;
+
+typedef struct
+{
+    size_t count;
+    size_t capacity;
+    AssemblySwitch *frames;
+} AssemblySwitchStack;
+
+typedef struct
+{
+    uint32_t low;
+    uint32_t high;
+    size_t label;
+} SwitchSearchRange;
+
+typedef struct
+{
+    uint64_t count;
+    uint32_t position;
+} SwitchCaseWeight;
+
+typedef struct
+{
+    AssemblyBuffer text;
+    AssemblyBuffer data;
+    AssemblyBuffer rodata;
+    AssemblyBuffer bss;
+    AssemblyBuffer profileTable;
+    AssemblyBuffer cold;
+    AssemblyLiteralPool literals;
+    Ast **trees;
+    size_t firstAst;
+    size_t astCount;
+    size_t currentAst;
+    size_t labelCount;
+    uint32_t constants;
+    const TypeTable *types;
+    AstWalker walker;
+    AssemblySwitchStack switches;
+    InstructionSelector selector;
+    ProfileMode profileMode;
+    const ProfileData *profile;
+    const uint64_t *profileCounters;
+    uint32_t counterCount;
+    uint32_t functionCount;
+    bool inCold;
+    bool hadError;
+    uint32_t errorLine;
+} AssemblyUnit;
+
 typedef struct Assembler
 {
     AstArray trees;
-    FILE *output;
+    AssemblyBuffer output;
     size_t currentAst;
+    uint32_t threadCount;
+    const TypeTable *types;
+    ProfileMode profileMode;
+    const char *profilePath;
+    ProfileData profile;
+    bool hadError;
+    uint32_t errorLine;
 } Assembler;
 
-void initAssembler(Assembler *assembler, const char *outputPath);
+void initAssembler(Assembler *assembler);
+void resetAssembler(Assembler *assembler);
+void freeAssembler(Assembler *assembler);
 void setAssemblerAstArray(Assembler *assembler, AstArray array);
-void emitAssembly(Assembler *assembler);
+void setAssemblerTypeTable(Assembler *assembler, const TypeTable *types);
+void setAssemblerProfile(Assembler *assembler, ProfileMode mode, const char *profilePath);
+bool emitAssembly(Assembler *assembler);
 bool assemblerHasAst(Assembler *assembler);
 Ast *getAssemblerNextAst(Assembler *assembler);
-void emitAssemblyForAst(Assembler *assembler, Ast *ast);
-void emitAssemblyForLiteralExpression(Assembler *assembler, AstLiteralExpression *ast);
 
-#endif
\ No newline at end of file
+void initAssemblyBuffer(AssemblyBuffer *buffer);
+void appendAssemblyBuffer(AssemblyBuffer *buffer, const char *format, ...);
+void writeAssemblyBuffer(AssemblyBuffer *buffer, const char *data, size_t count);
+void freeAssemblyBuffer(AssemblyBuffer *buffer);
+
+void initAssemblyLiteralPool(AssemblyLiteralPool *pool);
+void freeAssemblyLiteralPool(AssemblyLiteralPool *pool);
+bool internAssemblyLiteral(AssemblyLiteralPool *pool, AssemblyLiteral literal);
+
+void initAssemblyUnit(AssemblyUnit *unit, Ast **trees, size_t firstAst, size_t astCount, const TypeTable *types);
+void freeAssemblyUnit(AssemblyUnit *unit);
+bool emitAssemblyUnit(AssemblyUnit *unit);
+bool emitAssemblyForAst(AssemblyUnit *unit, Ast *ast);
+bool emitAssemblyForExpression(AssemblyUnit *unit, Ast *ast, SelectionNonterminal goal);
+void emitAssemblyForFunctionDeclaration(AssemblyUnit *unit, AstFunctionDeclaration *ast);
+void emitAssemblyForSwitchStatement(AssemblyUnit *unit);
+void emitAssemblyForSwitchDispatch(AssemblyUnit *unit, AssemblySwitch *frame);
+void emitAssemblyForCaseLabel(AssemblyUnit *unit, AstCaseLabel *ast);
+void emitAssemblyForBreakStatement(AssemblyUnit *unit);
+SwitchLowering chooseSwitchLowering(const AstSwitchStatement *ast, bool wide);
+SwitchLowering chooseProfiledSwitchLowering(const AstSwitchStatement *ast, const uint64_t *counts,
+                                            const uint32_t *order);
+
+#endif
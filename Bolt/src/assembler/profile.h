@@ -0,0 +1,42 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <parsing.h>
+#include <walker.h>
+#include <hashmap.h>
+
+#define PROFILE_MAGIC 0x46525042
+#define PROFILE_VERSION 1
+#define PROFILE_HEADER_SIZE 12
+#define PROFILE_RECORD_SIZE 12
+#define PROFILE_COUNTER_SIZE 8
+#define PROFILE_HOT_CASE_PERCENT 50
+
+typedef enum
+{
+    PROFILE_MODE_NONE,
+    PROFILE_MODE_GENERATE,
+    PROFILE_MODE_USE,
+} ProfileMode;
+
+typedef struct
+{
+    uint64_t key;
+    uint32_t counterCount;
+    size_t offset;
+} ProfileRecord;
+
+typedef struct
+{
+    HashMap records;
+    size_t counterCount;
+    uint64_t *counters;
+} ProfileData;
+
+void initProfileData(ProfileData *profile);
+void freeProfileData(ProfileData *profile);
+bool loadProfileData(ProfileData *profile, const char *path);
+const uint64_t *findProfileCounters(const ProfileData *profile, uint64_t key, uint32_t counterCount);
+uint32_t countProfileCounters(AstFunctionDeclaration *function);
+
+#endif
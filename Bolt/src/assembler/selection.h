@@ -0,0 +1,100 @@
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include <parsing.h>
+#include <types.h>
+#include <array.h>
+
+#define SELECTION_COST_INFINITE UINT32_MAX
+#define SELECTION_STATE_NONE UINT32_MAX
+#define SELECTION_CHAIN_PASSES 4
+
+typedef enum
+{
+    SELECTION_NONTERMINAL_NONE,
+    SELECTION_NONTERMINAL_STACK,
+    SELECTION_NONTERMINAL_REGISTER,
+    SELECTION_NONTERMINAL_IMMEDIATE,
+    SELECTION_NONTERMINAL_ADDRESS,
+    SELECTION_NONTERMINAL_MEMORY,
+    SELECTION_NONTERMINAL_XMM,
+    SELECTION_NONTERMINAL_X87,
+    SELECTION_NONTERMINAL_COUNT,
+} SelectionNonterminal;
+
+typedef enum
+{
+    SELECTION_OPERATOR_NONE,
+    SELECTION_OPERATOR_CONSTANT_I4,
+    SELECTION_OPERATOR_CONSTANT_I8,
+    SELECTION_OPERATOR_CONSTANT_F4,
+    SELECTION_OPERATOR_CONSTANT_F8,
+    SELECTION_OPERATOR_CONSTANT_F10,
+    SELECTION_OPERATOR_ADDRESS_P4,
+    SELECTION_OPERATOR_NEGATE_I4,
+    SELECTION_OPERATOR_NEGATE_I8,
+    SELECTION_OPERATOR_NEGATE_F4,
+    SELECTION_OPERATOR_NEGATE_F8,
+    SELECTION_OPERATOR_NEGATE_F10,
+    SELECTION_OPERATOR_NOT_I4,
+    SELECTION_OPERATOR_NOT_I8,
+    SELECTION_OPERATOR_NOT_F4,
+    SELECTION_OPERATOR_NOT_F8,
+    SELECTION_OPERATOR_NOT_F10,
+    SELECTION_OPERATOR_COUNT,
+} SelectionOperator;
+
+typedef struct
+{
+    SelectionNonterminal result;
+    SelectionOperator root;
+    SelectionOperator inner;
+    SelectionNonterminal operand;
+    uint32_t size;
+    uint32_t cost;
+    uint32_t constants;
+    const char *text;
+} SelectionRule;
+
+typedef struct
+{
+    Ast *ast;
+    SelectionOperator op;
+    uint32_t size;
+    uint32_t child;
+    size_t label;
+    uint32_t cost[SELECTION_NONTERMINAL_COUNT];
+    uint16_t rule[SELECTION_NONTERMINAL_COUNT];
+} SelectionState;
+
+typedef struct
+{
+    uint32_t state;
+    SelectionNonterminal nonterminal;
+    bool expanded;
+} SelectionTask;
+
+typedef struct
+{
+    const SelectionRule *rule;
+    uint32_t state;
+    uint32_t operand;
+} SelectionReduction;
+
+DECLARE_ARRAY(SelectionStateArray, SelectionState, states);
+DECLARE_ARRAY(SelectionTaskArray, SelectionTask, tasks);
+DECLARE_ARRAY(SelectionReductionArray, SelectionReduction, reductions);
+
+typedef struct
+{
+    SelectionStateArray states;
+    SelectionTaskArray tasks;
+    SelectionReductionArray reductions;
+} InstructionSelector;
+
+void initInstructionSelector(InstructionSelector *selector);
+void freeInstructionSelector(InstructionSelector *selector);
+bool selectInstructions(InstructionSelector *selector, const TypeTable *types, Ast *ast, SelectionNonterminal goal);
+SelectionOperator getSelectionOperator(const TypeTable *types, Ast *ast);
+
+#endif
@@ -1,19 +1,636 @@
 #include <assembling.h>
+#include <memory.h>
+#include <array.h>
+#include <parallel.h>
+#include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
 
-void initAssembler(Assembler *assembler, const char *outputPath)
+DEFINE_ARRAY(AssemblyLiteralArray, AssemblyLiteral, literals)
+
+static uint64_t hashAssemblyLiteral(AssemblyLiteral literal)
+{
+    uint64_t hash = literal.bits ^ ((uint64_t)literal.width << 59);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static uint64_t hashAssemblyLiteralSlot(const void *slot)
+{
+    return hashAssemblyLiteral(*(const AssemblyLiteral *)slot);
+}
+
+static AssemblyLiteral getSelectionLiteral(const SelectionState *state)
+{
+    double floating = ((AstLiteralExpression *)state->ast)->value.value.floating;
+    AssemblyLiteral literal = {0, 8};
+
+    if (state->op == SELECTION_OPERATOR_CONSTANT_F4)
+    {
+        float single = (float)floating;
+        uint32_t bits;
+        memcpy(&bits, &single, sizeof(bits));
+        literal.bits = bits;
+        literal.width = 4;
+        return literal;
+    }
+
+    memcpy(&literal.bits, &floating, sizeof(literal.bits));
+    return literal;
+}
+
+static void appendAssemblyLiteralLabel(AssemblyBuffer *buffer, AssemblyLiteral literal)
+{
+    if (literal.width == 4)
+    {
+        appendAssemblyBuffer(buffer, "float_literal_4_%08" PRIX32, (uint32_t)literal.bits);
+        return;
+    }
+
+    appendAssemblyBuffer(buffer, "float_literal_8_%016" PRIX64, literal.bits);
+}
+
+static void defineAssemblyLiteral(AssemblyBuffer *buffer, AssemblyLiteral literal)
+{
+    appendAssemblyBuffer(buffer, literal.width == 4 ? "\t" : "\talign 8\n\t");
+    appendAssemblyLiteralLabel(buffer, literal);
+
+    if (literal.width == 4)
+    {
+        appendAssemblyBuffer(buffer, " dd 0x%08" PRIX32 "\n", (uint32_t)literal.bits);
+        return;
+    }
+
+    appendAssemblyBuffer(buffer, " dq 0x%016" PRIX64 "\n", literal.bits);
+}
+
+static void defineSelectionConstant(AssemblyUnit *unit, SelectionState *state)
+{
+    AstLiteralExpression *literal = (AstLiteralExpression *)state->ast;
+
+    switch (state->op)
+    {
+    case SELECTION_OPERATOR_CONSTANT_F4:
+    case SELECTION_OPERATOR_CONSTANT_F8:
+    case SELECTION_OPERATOR_CONSTANT_F10:
+        internAssemblyLiteral(&unit->literals, getSelectionLiteral(state));
+        break;
+
+    case SELECTION_OPERATOR_ADDRESS_P4:
+        state->label = unit->labelCount++;
+        appendAssemblyBuffer(&unit->data, "\tstring_literal_%zu_%zu db \"%s\", 0\n", unit->currentAst, state->label,
+                             literal->value.value.string);
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void emitSelectionOperand(AssemblyUnit *unit, const SelectionState *state, char placeholder)
+{
+    uint64_t value = ((AstLiteralExpression *)state->ast)->value.value.integer;
+
+    switch (placeholder)
+    {
+    case 'L':
+        appendAssemblyBuffer(&unit->text, "%" PRIu32, (uint32_t)value);
+        break;
+
+    case 'H':
+        appendAssemblyBuffer(&unit->text, "%" PRIu32, (uint32_t)(value >> 32));
+        break;
+
+    case 'M':
+        if (state->op == SELECTION_OPERATOR_ADDRESS_P4)
+        {
+            appendAssemblyBuffer(&unit->text, "string_literal_%zu_%zu", unit->currentAst, state->label);
+        }
+        else
+        {
+            appendAssemblyLiteralLabel(&unit->text, getSelectionLiteral(state));
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void emitSelectionRule(AssemblyUnit *unit, const SelectionRule *rule, const SelectionState *operand)
+{
+    const char *text = rule->text;
+    const char *placeholder;
+
+    while ((placeholder = strchr(text, '%')) != NULL)
+    {
+        writeAssemblyBuffer(&unit->text, text, (size_t)(placeholder - text));
+        emitSelectionOperand(unit, operand, placeholder[1]);
+        text = placeholder + 2;
+    }
+
+    writeAssemblyBuffer(&unit->text, text, strlen(text));
+    unit->constants |= rule->constants;
+}
+
+static AssemblySwitch *getCurrentSwitch(AssemblyUnit *unit)
+{
+    return unit->switches.count > 0 ? &unit->switches.frames[unit->switches.count - 1] : NULL;
+}
+
+static void pushAssemblySwitch(AssemblyUnit *unit, AstSwitchStatement *ast)
+{
+    AssemblySwitchStack *stack = &unit->switches;
+
+    if (stack->count >= stack->capacity)
+    {
+        size_t oldCapacity = stack->capacity;
+        stack->capacity = oldCapacity * ARRAY_GROW_FACTOR;
+        stack->frames = REALLOCATE(AssemblySwitch, stack->frames, oldCapacity, stack->capacity);
+    }
+
+    AssemblySwitch *frame = &stack->frames[stack->count++];
+    frame->statement = ast;
+    frame->label = unit->labelCount++;
+    frame->dispatched = false;
+    frame->firstCounter = unit->counterCount;
+    frame->hotCounter = SWITCH_HOT_COUNTER_NONE;
+    frame->hotReached = false;
+    frame->terminated = false;
+    frame->cold = false;
+    unit->counterCount += ast->caseCount + 1;
+}
+
+static const char *getSwitchDefaultLabel(const AssemblyUnit *unit, const AssemblySwitch *frame)
+{
+    if (frame->statement->defaultCase != NULL)
+    {
+        return "default";
+    }
+
+    return unit->profileMode == PROFILE_MODE_GENERATE ? "miss" : "end";
+}
+
+static void emitProfileCounter(AssemblyUnit *unit, uint32_t counter)
+{
+    uint32_t offset = counter * PROFILE_COUNTER_SIZE;
+    appendAssemblyBuffer(&unit->text, "\tadd dword [profile_counters_%zu + %" PRIu32 "], 1\n", unit->currentAst, offset);
+    appendAssemblyBuffer(&unit->text, "\tadc dword [profile_counters_%zu + %" PRIu32 "], 0\n", unit->currentAst,
+                         offset + 4);
+}
+
+static void appendCaseLabel(AssemblyUnit *unit, AssemblySwitch *frame, AstCaseLabel *ast, const char *prefix,
+                            const char *suffix)
+{
+    if (ast->value == NULL)
+    {
+        appendAssemblyBuffer(&unit->text, "%sswitch_%zu_%zu_default%s", prefix, unit->currentAst, frame->label, suffix);
+        return;
+    }
+
+    appendAssemblyBuffer(&unit->text, "%sswitch_%zu_%zu_case_%" PRIu32 "%s", prefix, unit->currentAst, frame->label,
+                         ast->index, suffix);
+}
+
+static void swapColdSection(AssemblyUnit *unit, AssemblySwitch *frame)
+{
+    AssemblyBuffer text = unit->text;
+    unit->text = unit->cold;
+    unit->cold = text;
+    unit->inCold = !unit->inCold;
+    frame->cold = !frame->cold;
+}
+
+static void placeCaseBlock(AssemblyUnit *unit, AssemblySwitch *frame, AstCaseLabel *ast, uint32_t counter)
+{
+    if (unit->profileCounters[0] == 0 || (unit->inCold && !frame->cold))
+    {
+        return;
+    }
+
+    bool early = frame->hotCounter != SWITCH_HOT_COUNTER_NONE && !frame->hotReached && counter != frame->hotCounter;
+    bool cold = (early || unit->profileCounters[counter] == 0) && (frame->terminated || frame->cold);
+
+    frame->hotReached |= counter == frame->hotCounter;
+
+    if (frame->cold && !cold)
+    {
+        if (!frame->terminated)
+        {
+            appendCaseLabel(unit, frame, ast, "\tjmp ", "\n");
+        }
+
+        swapColdSection(unit, frame);
+    }
+    else if (!frame->cold && cold)
+    {
+        swapColdSection(unit, frame);
+    }
+}
+
+static void emitSwitchCompares(AssemblyUnit *unit, AssemblySwitch *frame, uint32_t low, uint32_t high)
+{
+    for (uint32_t i = low; i < high; i++)
+    {
+        AstCaseLabel *label = frame->statement->cases[i];
+        appendAssemblyBuffer(&unit->text, "\tcmp eax, %" PRIu32 "\n\tje switch_%zu_%zu_case_%" PRIu32 "\n",
+                             (uint32_t)label->constant, unit->currentAst, frame->label, label->index);
+    }
+}
+
+static void emitWideSwitchCompares(AssemblyUnit *unit, AssemblySwitch *frame, const uint32_t *order)
+{
+    for (uint32_t i = 0; i < frame->statement->caseCount; i++)
+    {
+        AstCaseLabel *label = frame->statement->cases[order != NULL ? order[i] : i];
+        appendAssemblyBuffer(&unit->text, "\tcmp eax, %" PRIu32 "\n\tjne switch_%zu_%zu_next_%" PRIu32 "\n",
+                             (uint32_t)label->constant, unit->currentAst, frame->label, i);
+        appendAssemblyBuffer(&unit->text, "\tcmp edx, %" PRIu32 "\n\tje switch_%zu_%zu_case_%" PRIu32 "\n",
+                             (uint32_t)(label->constant >> 32), unit->currentAst, frame->label, label->index);
+        appendAssemblyBuffer(&unit->text, "switch_%zu_%zu_next_%" PRIu32 ":\n", unit->currentAst, frame->label, i);
+    }
+}
+
+static void emitSwitchSearch(AssemblyUnit *unit, AssemblySwitch *frame)
+{
+    AstSwitchStatement *ast = frame->statement;
+    const char *greater = getType(unit->types, ast->selectorType)->isUnsigned ? "ja" : "jg";
+    SwitchSearchRange stack[SWITCH_SEARCH_MAX_DEPTH];
+    size_t count = 0;
+    size_t nextRange = 0;
+
+    stack[count++] = (SwitchSearchRange){0, ast->caseCount, nextRange++};
+
+    while (count > 0)
+    {
+        SwitchSearchRange range = stack[--count];
+        appendAssemblyBuffer(&unit->text, "switch_%zu_%zu_range_%zu:\n", unit->currentAst, frame->label, range.label);
+
+        if (range.high - range.low <= SWITCH_SEARCH_LEAF_CASES)
+        {
+            emitSwitchCompares(unit, frame, range.low, range.high);
+            appendAssemblyBuffer(&unit->text, "\tjmp switch_%zu_%zu_%s\n", unit->currentAst, frame->label,
+                                 getSwitchDefaultLabel(unit, frame));
+            continue;
+        }
+
+        uint32_t middle = range.low + (range.high - range.low) / 2;
+        size_t right = nextRange++;
+
+        emitSwitchCompares(unit, frame, middle, middle + 1);
+        appendAssemblyBuffer(&unit->text, "\t%s switch_%zu_%zu_range_%zu\n", greater, unit->currentAst, frame->label,
+                             right);
+
+        stack[count++] = (SwitchSearchRange){middle + 1, range.high, right};
+        stack[count++] = (SwitchSearchRange){range.low, middle, nextRange++};
+    }
+}
+
+static void emitSwitchTable(AssemblyUnit *unit, AssemblySwitch *frame)
+{
+    AstSwitchStatement *ast = frame->statement;
+    uint64_t first = ast->cases[0]->key;
+    uint64_t range = ast->cases[ast->caseCount - 1]->key - first + 1;
+
+    if ((uint32_t)ast->cases[0]->constant != 0)
+    {
+        appendAssemblyBuffer(&unit->text, "\tsub eax, %" PRIu32 "\n", (uint32_t)ast->cases[0]->constant);
+    }
+
+    appendAssemblyBuffer(&unit->text, "\tcmp eax, %" PRIu64 "\n\tja switch_%zu_%zu_%s\n", range - 1, unit->currentAst,
+                         frame->label, getSwitchDefaultLabel(unit, frame));
+    appendAssemblyBuffer(&unit->text, "\tjmp [switch_%zu_%zu_table + eax*4]\n", unit->currentAst, frame->label);
+    appendAssemblyBuffer(&unit->rodata, "\talign 4\n\tswitch_%zu_%zu_table", unit->currentAst, frame->label);
+
+    uint32_t next = 0;
+
+    for (uint64_t slot = 0; slot < range; slot++)
+    {
+        appendAssemblyBuffer(&unit->rodata, "%sdd switch_%zu_%zu_", slot == 0 ? " " : "\t", unit->currentAst, frame->label);
+
+        if (ast->cases[next]->key - first == slot)
+        {
+            appendAssemblyBuffer(&unit->rodata, "case_%" PRIu32 "\n", ast->cases[next++]->index);
+        }
+        else
+        {
+            appendAssemblyBuffer(&unit->rodata, "%s\n", getSwitchDefaultLabel(unit, frame));
+        }
+    }
+}
+
+static int compareSwitchCaseWeights(const void *a, const void *b)
+{
+    const SwitchCaseWeight *left = a;
+    const SwitchCaseWeight *right = b;
+
+    if (left->count != right->count)
+    {
+        return left->count > right->count ? -1 : 1;
+    }
+
+    return left->position < right->position ? -1 : left->position > right->position;
+}
+
+static void emitStaticSwitchDispatch(AssemblyUnit *unit, AssemblySwitch *frame, bool wide)
+{
+    AstSwitchStatement *ast = frame->statement;
+
+    switch (chooseSwitchLowering(ast, wide))
+    {
+    case SWITCH_LOWERING_JUMP_TABLE:
+        emitSwitchTable(unit, frame);
+        return;
+
+    case SWITCH_LOWERING_BINARY_SEARCH:
+        emitSwitchSearch(unit, frame);
+        return;
+
+    default:
+        if (wide)
+        {
+            emitWideSwitchCompares(unit, frame, NULL);
+        }
+        else
+        {
+            emitSwitchCompares(unit, frame, 0, ast->caseCount);
+        }
+
+        appendAssemblyBuffer(&unit->text, "\tjmp switch_%zu_%zu_%s\n", unit->currentAst, frame->label,
+                             getSwitchDefaultLabel(unit, frame));
+        return;
+    }
+}
+
+static void emitProfileRuntime(Assembler *assembler, AssemblyUnit *units, size_t unitCount, uint32_t functionCount)
+{
+    appendAssemblyBuffer(&assembler->output, "\tbolt_profile_header dd 0x%08X, %d, %" PRIu32 "\n", PROFILE_MAGIC,
+                         PROFILE_VERSION, functionCount);
+    appendAssemblyBuffer(&assembler->output, "\tbolt_profile_path db \"%s\", 0\n\tbolt_profile_mode db \"wb\", 0\n",
+                         assembler->profilePath);
+    appendAssemblyBuffer(&assembler->output, "\talign 4\nbolt_profile_functions:\n");
+
+    for (size_t i = 0; i < unitCount; i++)
+    {
+        writeAssemblyBuffer(&assembler->output, units[i].profileTable.data, units[i].profileTable.count);
+    }
+
+    appendAssemblyBuffer(&assembler->output, "bolt_profile_functions_end:\n");
+}
+
+static void emitProfileDumpRoutine(Assembler *assembler)
+{
+    appendAssemblyBuffer(&assembler->output, "\textern fopen, fwrite, fclose, atexit\n"
+                                             "bolt_profile_dump:\n\tpush ebx\n\tpush esi\n"
+                                             "\tpush bolt_profile_mode\n\tpush bolt_profile_path\n\tcall fopen\n"
+                                             "\tadd esp, 8\n\ttest eax, eax\n\tjz bolt_profile_dump_done\n"
+                                             "\tmov ebx, eax\n\tpush ebx\n\tpush 1\n\tpush %d\n"
+                                             "\tpush bolt_profile_header\n\tcall fwrite\n\tadd esp, 16\n"
+                                             "\tmov esi, bolt_profile_functions\n",
+                         PROFILE_HEADER_SIZE);
+    appendAssemblyBuffer(&assembler->output, "bolt_profile_dump_next:\n"
+                                             "\tcmp esi, bolt_profile_functions_end\n\tjae bolt_profile_dump_close\n"
+                                             "\tpush ebx\n\tpush 1\n\tpush %d\n\tpush esi\n\tcall fwrite\n"
+                                             "\tadd esp, 16\n\tpush ebx\n\tpush dword [esi + 8]\n\tpush %d\n"
+                                             "\tpush dword [esi + 12]\n\tcall fwrite\n\tadd esp, 16\n"
+                                             "\tadd esi, 16\n\tjmp bolt_profile_dump_next\n",
+                         PROFILE_RECORD_SIZE, PROFILE_COUNTER_SIZE);
+    appendAssemblyBuffer(&assembler->output, "bolt_profile_dump_close:\n\tpush ebx\n\tcall fclose\n\tadd esp, 4\n"
+                                             "bolt_profile_dump_done:\n\tpop esi\n\tpop ebx\n\tret\n");
+}
+
+static void emitProfiledSwitchDispatch(AssemblyUnit *unit, AssemblySwitch *frame, bool wide)
+{
+    AstSwitchStatement *ast = frame->statement;
+    const uint64_t *counts = unit->profileCounters + frame->firstCounter;
+    SwitchCaseWeight *weights = ALLOCATE(SwitchCaseWeight, ast->caseCount);
+    uint32_t *order = ALLOCATE(uint32_t, ast->caseCount);
+    uint64_t total = counts[ast->caseCount];
+
+    for (uint32_t i = 0; i < ast->caseCount; i++)
+    {
+        weights[i] = (SwitchCaseWeight){counts[ast->cases[i]->index], i};
+        total += weights[i].count;
+    }
+
+    qsort(weights, ast->caseCount, sizeof(SwitchCaseWeight), compareSwitchCaseWeights);
+
+    for (uint32_t i = 0; i < ast->caseCount; i++)
+    {
+        order[i] = weights[i].position;
+    }
+
+    if (ast->defaultCase != NULL && counts[ast->caseCount] > weights[0].count)
+    {
+        frame->hotCounter = frame->firstCounter + ast->caseCount;
+    }
+    else if (weights[0].count > 0)
+    {
+        frame->hotCounter = frame->firstCounter + ast->cases[order[0]]->index;
+    }
+
+    SwitchLowering lowering = wide ? SWITCH_LOWERING_LINEAR : chooseProfiledSwitchLowering(ast, counts, order);
+
+    if (lowering == SWITCH_LOWERING_LINEAR)
+    {
+        if (wide)
+        {
+            emitWideSwitchCompares(unit, frame, order);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < ast->caseCount; i++)
+            {
+                emitSwitchCompares(unit, frame, order[i], order[i] + 1);
+            }
+        }
+
+        appendAssemblyBuffer(&unit->text, "\tjmp switch_%zu_%zu_%s\n", unit->currentAst, frame->label,
+                             getSwitchDefaultLabel(unit, frame));
+    }
+    else
+    {
+        if (weights[0].count > 0 && (double)weights[0].count * 100 >= (double)total * PROFILE_HOT_CASE_PERCENT)
+        {
+            emitSwitchCompares(unit, frame, order[0], order[0] + 1);
+        }
+
+        if (lowering == SWITCH_LOWERING_JUMP_TABLE)
+        {
+            emitSwitchTable(unit, frame);
+        }
+        else
+        {
+            emitSwitchSearch(unit, frame);
+        }
+    }
+
+    FREE(weights);
+    FREE(order);
+}
+
+static uint64_t getSwitchSearchCost(uint64_t count)
+{
+    uint64_t levels = 0;
+
+    while (((uint64_t)1 << levels) < count + 1)
+    {
+        levels++;
+    }
+
+    return 2 * levels;
+}
+
+static uint64_t getSwitchTableCost(const AstSwitchStatement *ast)
+{
+    uint64_t count = ast->caseCount;
+    uint64_t range = ast->cases[count - 1]->key - ast->cases[0]->key + 1;
+
+    if (range > SWITCH_TABLE_MAX_ENTRIES)
+    {
+        return UINT64_MAX;
+    }
+
+    return SWITCH_TABLE_DISPATCH_COST + (range - count) / SWITCH_TABLE_HOLES_PER_COMPARE;
+}
+
+static AstWalkAction enterAssemblyNode(Ast *ast, void *context)
+{
+    AssemblyUnit *unit = context;
+
+    if (ast->type == AST_TYPE_LITERAL_EXPRESSION_NODE || ast->type == AST_TYPE_UNARY_EXPRESSION_NODE)
+    {
+        AssemblySwitch *frame = getCurrentSwitch(unit);
+        bool selector = frame != NULL && !frame->dispatched && frame->statement->selector == ast;
+        SelectionNonterminal goal = selector ? SELECTION_NONTERMINAL_REGISTER : SELECTION_NONTERMINAL_STACK;
+        return emitAssemblyForExpression(unit, ast, goal) ? AST_WALK_SKIP_CHILDREN : AST_WALK_STOP;
+    }
+
+    if (ast->type == AST_TYPE_SWITCH_STATEMENT_NODE)
+    {
+        pushAssemblySwitch(unit, (AstSwitchStatement *)ast);
+        return AST_WALK_CONTINUE;
+    }
+
+    if (ast->type == AST_TYPE_CASE_LABEL_NODE)
+    {
+        return AST_WALK_SKIP_CHILDREN;
+    }
+
+    if (ast->type != AST_TYPE_FUNCTION_DECLARATION_NODE)
+    {
+        return AST_WALK_CONTINUE;
+    }
+
+    AstFunctionDeclaration *function = (AstFunctionDeclaration *)ast;
+
+    if (!function->parsed)
+    {
+        return AST_WALK_SKIP_CHILDREN;
+    }
+
+    if (!function->internal)
+    {
+        appendAssemblyBuffer(&unit->text, "\tglobal %s\n", function->name.lexeme);
+    }
+
+    appendAssemblyBuffer(&unit->text, "%s:\n\tpush ebp\n\tmov ebp, esp\n", function->name.lexeme);
+    unit->counterCount = 1;
+
+    if (unit->profileMode == PROFILE_MODE_GENERATE)
+    {
+        emitProfileCounter(unit, 0);
+
+        if (strcmp(function->name.lexeme, "main") == 0)
+        {
+            appendAssemblyBuffer(&unit->text, "\tpush bolt_profile_dump\n\tcall atexit\n\tadd esp, 4\n");
+        }
+    }
+    else if (unit->profileMode == PROFILE_MODE_USE)
+    {
+        unit->profileCounters =
+            findProfileCounters(unit->profile, hashFunctionName(function->name.lexeme), countProfileCounters(function));
+    }
+
+    return AST_WALK_CONTINUE;
+}
+
+static AstWalkAction emitAssemblyForNode(Ast *ast, void *context)
+{
+    AssemblyUnit *unit = context;
+
+    switch (ast->type)
+    {
+    case AST_TYPE_FUNCTION_DECLARATION_NODE:
+        emitAssemblyForFunctionDeclaration(unit, (AstFunctionDeclaration *)ast);
+        break;
+
+    case AST_TYPE_SWITCH_STATEMENT_NODE:
+        emitAssemblyForSwitchStatement(unit);
+        break;
+
+    case AST_TYPE_CASE_LABEL_NODE:
+        emitAssemblyForCaseLabel(unit, (AstCaseLabel *)ast);
+        break;
+
+    case AST_TYPE_BREAK_STATEMENT_NODE:
+        emitAssemblyForBreakStatement(unit);
+        break;
+
+    default:
+        break;
+    }
+
+    AssemblySwitch *frame = getCurrentSwitch(unit);
+
+    if (frame != NULL && !frame->dispatched && frame->statement->selector == ast)
+    {
+        emitAssemblyForSwitchDispatch(unit, frame);
+    }
+
+    return AST_WALK_CONTINUE;
+}
+
+static void emitAssemblyUnitTask(void *context, size_t index)
+{
+    emitAssemblyUnit(&((AssemblyUnit *)context)[index]);
+}
+
+void initAssembler(Assembler *assembler)
 {
     assembler->trees.capacity = 0;
     assembler->trees.count = 0;
     assembler->trees.trees = NULL;
     assembler->currentAst = 0;
-    assembler->output = fopen(outputPath, "w");
+    assembler->threadCount = (uint32_t)getProcessorCount();
+    assembler->types = NULL;
+    assembler->profileMode = PROFILE_MODE_NONE;
+    assembler->profilePath = NULL;
+    assembler->hadError = false;
+    assembler->errorLine = 0;
+    initProfileData(&assembler->profile);
+    initAssemblyBuffer(&assembler->output);
+}
 
-    if (!assembler->output)
-    {
-        perror("Failed to open output file");
-        exit(EXIT_FAILURE);
-    }
+void resetAssembler(Assembler *assembler)
+{
+    assembler->trees.capacity = 0;
+    assembler->trees.count = 0;
+    assembler->trees.trees = NULL;
+    assembler->currentAst = 0;
+    assembler->output.count = 0;
+    assembler->hadError = false;
+    assembler->errorLine = 0;
+}
+
+void freeAssembler(Assembler *assembler)
+{
+    resetAssembler(assembler);
+    freeAssemblyBuffer(&assembler->output);
+    freeProfileData(&assembler->profile);
 }
 
 void setAssemblerAstArray(Assembler *assembler, AstArray array)
@@ -21,14 +638,159 @@ void setAssemblerAstArray(Assembler *assembler, AstArray array)
     assembler->trees = array;
 }
 
-void emitAssembly(Assembler *assembler)
+void setAssemblerTypeTable(Assembler *assembler, const TypeTable *types)
 {
-    while (assemblerHasAst(assembler))
+    assembler->types = types;
+}
+
+void setAssemblerProfile(Assembler *assembler, ProfileMode mode, const char *profilePath)
+{
+    assembler->profileMode = mode;
+    assembler->profilePath = profilePath;
+}
+
+bool emitAssembly(Assembler *assembler)
+{
+    size_t first = assembler->currentAst;
+    size_t count = assembler->trees.count - first;
+    size_t unitCount = 1;
+
+    if (assembler->threadCount > 1 && count >= PARALLEL_EMIT_MIN_TREES)
+    {
+        unitCount = (size_t)assembler->threadCount * PARALLEL_EMIT_UNITS_PER_THREAD;
+
+        if (unitCount > count)
+        {
+            unitCount = count;
+        }
+    }
+
+    AssemblyUnit *units = ALLOCATE(AssemblyUnit, unitCount);
+
+    for (size_t i = 0; i < unitCount; i++)
+    {
+        size_t begin = first + count * i / unitCount;
+        size_t end = first + count * (i + 1) / unitCount;
+        initAssemblyUnit(&units[i], assembler->trees.trees, begin, end - begin, assembler->types);
+        units[i].profileMode = assembler->profileMode;
+        units[i].profile = &assembler->profile;
+    }
+
+    assembler->currentAst = assembler->trees.count;
+
+    runParallel(emitAssemblyUnitTask, units, unitCount, assembler->threadCount);
+
+    for (size_t i = 0; i < unitCount && !assembler->hadError; i++)
+    {
+        assembler->hadError = units[i].hadError;
+        assembler->errorLine = units[i].errorLine;
+    }
+
+    if (assembler->hadError)
+    {
+        for (size_t i = 0; i < unitCount; i++)
+        {
+            freeAssemblyUnit(&units[i]);
+        }
+
+        FREE(units);
+        return false;
+    }
+
+    size_t dataSize = 0;
+    size_t rodataSize = 0;
+    AssemblyLiteralPool literals;
+    size_t bssSize = 0;
+    uint32_t functionCount = 0;
+    uint32_t constants = ASSEMBLY_CONSTANT_NONE;
+    bool instrumented = assembler->profileMode == PROFILE_MODE_GENERATE;
+
+    for (size_t i = 0; i < unitCount; i++)
+    {
+        dataSize += units[i].data.count;
+        rodataSize += units[i].rodata.count + units[i].literals.literals.count;
+        bssSize += units[i].bss.count;
+        functionCount += units[i].functionCount;
+        constants |= units[i].constants;
+    }
+
+    if (rodataSize > 0 || constants != ASSEMBLY_CONSTANT_NONE)
+    {
+        appendAssemblyBuffer(&assembler->output, "section .rodata\n\talign 16\n");
+
+        if ((constants & ASSEMBLY_CONSTANT_FLOAT_SIGN_MASK) != 0)
+        {
+            appendAssemblyBuffer(&assembler->output, "\tfloat_sign_mask dd 0x80000000, 0, 0, 0\n");
+        }
+
+        if ((constants & ASSEMBLY_CONSTANT_DOUBLE_SIGN_MASK) != 0)
+        {
+            appendAssemblyBuffer(&assembler->output, "\tdouble_sign_mask dq 0x8000000000000000, 0\n");
+        }
+
+        initAssemblyLiteralPool(&literals);
+
+        for (size_t i = 0; i < unitCount; i++)
+        {
+            for (size_t j = 0; j < units[i].literals.literals.count; j++)
+            {
+                AssemblyLiteral literal = units[i].literals.literals.literals[j];
+
+                if (internAssemblyLiteral(&literals, literal))
+                {
+                    defineAssemblyLiteral(&assembler->output, literal);
+                }
+            }
+        }
+
+        freeAssemblyLiteralPool(&literals);
+
+        for (size_t i = 0; i < unitCount; i++)
+        {
+            writeAssemblyBuffer(&assembler->output, units[i].rodata.data, units[i].rodata.count);
+        }
+    }
+
+    if (dataSize > 0 || instrumented)
+    {
+        appendAssemblyBuffer(&assembler->output, "section .data\n");
+
+        for (size_t i = 0; i < unitCount; i++)
+        {
+            writeAssemblyBuffer(&assembler->output, units[i].data.data, units[i].data.count);
+        }
+    }
+
+    if (instrumented)
     {
-        emitAssemblyForAst(assembler, getAssemblerNextAst(assembler));
+        emitProfileRuntime(assembler, units, unitCount, functionCount);
     }
 
-    fclose(assembler->output);
+    if (bssSize > 0)
+    {
+        appendAssemblyBuffer(&assembler->output, "section .bss\n\talign 8\n");
+
+        for (size_t i = 0; i < unitCount; i++)
+        {
+            writeAssemblyBuffer(&assembler->output, units[i].bss.data, units[i].bss.count);
+        }
+    }
+
+    appendAssemblyBuffer(&assembler->output, "section .text\n");
+
+    if (instrumented)
+    {
+        emitProfileDumpRoutine(assembler);
+    }
+
+    for (size_t i = 0; i < unitCount; i++)
+    {
+        writeAssemblyBuffer(&assembler->output, units[i].text.data, units[i].text.count);
+        freeAssemblyUnit(&units[i]);
+    }
+
+    FREE(units);
+    return true;
 }
 
 bool assemblerHasAst(Assembler *assembler)
@@ -41,44 +803,349 @@ Ast *getAssemblerNextAst(Assembler *assembler)
     return assembler->trees.trees[assembler->currentAst++];
 }
 
-void emitAssemblyForAst(Assembler *assembler, Ast *ast)
+void initAssemblyBuffer(AssemblyBuffer *buffer)
 {
-    switch (ast->type)
+    buffer->count = 0;
+    buffer->capacity = MIN_ARRAY_SIZE;
+    buffer->data = ALLOCATE(char, MIN_ARRAY_SIZE);
+}
+
+void appendAssemblyBuffer(AssemblyBuffer *buffer, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    size_t available = buffer->capacity - buffer->count;
+    int length = vsnprintf(buffer->data + buffer->count, available, format, args);
+    va_end(args);
+
+    if (length < 0)
     {
-    case AST_TYPE_LITERAL_EXPRESSION_NODE:
-        emitAssemblyForLiteralExpression(assembler, (AstLiteralExpression *)ast);
-        break;
+        return;
+    }
+
+    if ((size_t)length >= available)
+    {
+        size_t oldCapacity = buffer->capacity;
+        size_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
+
+        while (newCapacity - buffer->count <= (size_t)length)
+        {
+            newCapacity *= ARRAY_GROW_FACTOR;
+        }
+
+        buffer->data = REALLOCATE(char, buffer->data, oldCapacity, newCapacity);
+        buffer->capacity = newCapacity;
+
+        va_start(args, format);
+        vsnprintf(buffer->data + buffer->count, newCapacity - buffer->count, format, args);
+        va_end(args);
     }
+
+    buffer->count += (size_t)length;
 }
 
-void emitAssemblyForLiteralExpression(Assembler *assembler, AstLiteralExpression *ast)
+void writeAssemblyBuffer(AssemblyBuffer *buffer, const char *data, size_t count)
 {
-    switch (ast->value.type)
+    if (buffer->capacity - buffer->count < count)
     {
-    case TOKEN_ATTRIBUTE_TYPE_INT_LITERAL:
-        fprintf(assembler->output, "\tmov eax, %d\n", ast->value.value.integer);
-        fprintf(assembler->output, "\tpush eax\n");
-        break;
+        size_t oldCapacity = buffer->capacity;
+        size_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
 
-    case TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL:
-        fprintf(assembler->output, "section .data\n");
-        fprintf(assembler->output, "\tfloat_literal_%p dq %f\n", ast, ast->value.value.floating);
+        while (newCapacity - buffer->count < count)
+        {
+            newCapacity *= ARRAY_GROW_FACTOR;
+        }
 
-        fprintf(assembler->output, "section .text\n");
-        fprintf(assembler->output, "\tfld qword [float_literal_%p]\n", ast);
-        break;
+        buffer->data = REALLOCATE(char, buffer->data, oldCapacity, newCapacity);
+        buffer->capacity = newCapacity;
+    }
 
-    case TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL:
-        fprintf(assembler->output, "section .data\n");
-        fprintf(assembler->output, "\tstring_literal_%p db \"%s\", 0\n", ast, ast->value.value.string);
+    memcpy(buffer->data + buffer->count, data, count);
+    buffer->count += count;
+}
 
-        fprintf(assembler->output, "section .text\n");
-        fprintf(assembler->output, "\tmov eax, string_literal_%p\n", ast);
-        fprintf(assembler->output, "\tpush eax\n");
-        break;
+void freeAssemblyBuffer(AssemblyBuffer *buffer)
+{
+    FREE(buffer->data);
+    buffer->data = NULL;
+    buffer->count = 0;
+    buffer->capacity = 0;
+}
 
-    default:
-        fprintf(stderr, "Unsupported literal type in AST.\n");
-        break;
+void initAssemblyLiteralPool(AssemblyLiteralPool *pool)
+{
+    initHashMap(&pool->slots, sizeof(AssemblyLiteral), ASSEMBLY_LITERAL_POOL_MIN_SLOTS, hashAssemblyLiteralSlot);
+    initAssemblyLiteralArray(&pool->literals);
+}
+
+void freeAssemblyLiteralPool(AssemblyLiteralPool *pool)
+{
+    freeHashMap(&pool->slots);
+    freeAssemblyLiteralArray(&pool->literals);
+}
+
+bool internAssemblyLiteral(AssemblyLiteralPool *pool, AssemblyLiteral literal)
+{
+    uint64_t hash = hashAssemblyLiteral(literal);
+    HashMapProbe probe;
+    AssemblyLiteral *slot;
+
+    startHashMapProbe(&pool->slots, hash, &probe);
+
+    while ((slot = nextHashMapMatch(&pool->slots, &probe)) != NULL)
+    {
+        if (slot->bits == literal.bits && slot->width == literal.width)
+        {
+            return false;
+        }
+    }
+
+    *(AssemblyLiteral *)insertHashMap(&pool->slots, hash) = literal;
+    appendAssemblyLiteralArray(&pool->literals, literal);
+    return true;
+}
+
+void initAssemblyUnit(AssemblyUnit *unit, Ast **trees, size_t firstAst, size_t astCount, const TypeTable *types)
+{
+    initAssemblyBuffer(&unit->text);
+    initAssemblyBuffer(&unit->data);
+    initAssemblyBuffer(&unit->rodata);
+    initAssemblyBuffer(&unit->bss);
+    initAssemblyBuffer(&unit->profileTable);
+    initAssemblyBuffer(&unit->cold);
+    initAssemblyLiteralPool(&unit->literals);
+    unit->trees = trees;
+    unit->firstAst = firstAst;
+    unit->astCount = astCount;
+    unit->currentAst = firstAst;
+    unit->labelCount = 0;
+    unit->constants = ASSEMBLY_CONSTANT_NONE;
+    unit->types = types;
+    initAstWalker(&unit->walker);
+    initInstructionSelector(&unit->selector);
+    unit->switches.count = 0;
+    unit->switches.capacity = MIN_ARRAY_SIZE;
+    unit->switches.frames = ALLOCATE(AssemblySwitch, MIN_ARRAY_SIZE);
+    unit->profileMode = PROFILE_MODE_NONE;
+    unit->profile = NULL;
+    unit->profileCounters = NULL;
+    unit->counterCount = 0;
+    unit->functionCount = 0;
+    unit->inCold = false;
+    unit->hadError = false;
+    unit->errorLine = 0;
+}
+
+void freeAssemblyUnit(AssemblyUnit *unit)
+{
+    freeAssemblyBuffer(&unit->text);
+    freeAssemblyBuffer(&unit->data);
+    freeAssemblyBuffer(&unit->rodata);
+    freeAssemblyBuffer(&unit->bss);
+    freeAssemblyBuffer(&unit->profileTable);
+    freeAssemblyBuffer(&unit->cold);
+    freeAssemblyLiteralPool(&unit->literals);
+    freeAstWalker(&unit->walker);
+    freeInstructionSelector(&unit->selector);
+    FREE(unit->switches.frames);
+    unit->switches.frames = NULL;
+    unit->switches.count = 0;
+    unit->switches.capacity = 0;
+}
+
+bool emitAssemblyUnit(AssemblyUnit *unit)
+{
+    for (size_t i = unit->firstAst; i < unit->firstAst + unit->astCount && !unit->hadError; i++)
+    {
+        unit->currentAst = i;
+        unit->labelCount = 0;
+        unit->switches.count = 0;
+        unit->profileCounters = NULL;
+        unit->counterCount = 0;
+        emitAssemblyForAst(unit, unit->trees[i]);
+    }
+
+    return !unit->hadError;
+}
+
+bool emitAssemblyForAst(AssemblyUnit *unit, Ast *ast)
+{
+    AstVisitor visitor = {enterAssemblyNode, emitAssemblyForNode};
+    walkAst(&unit->walker, ast, &visitor, unit);
+    return !unit->hadError;
+}
+
+bool emitAssemblyForExpression(AssemblyUnit *unit, Ast *ast, SelectionNonterminal goal)
+{
+    InstructionSelector *selector = &unit->selector;
+
+    if (!selectInstructions(selector, unit->types, ast, goal))
+    {
+        unit->hadError = true;
+        unit->errorLine = ast->line;
+        return false;
+    }
+
+    for (size_t i = 0; i < selector->reductions.count; i++)
+    {
+        SelectionReduction *reduction = &selector->reductions.reductions[i];
+        SelectionState *operand = &selector->states.states[reduction->operand];
+
+        if (reduction->rule->root != SELECTION_OPERATOR_NONE && reduction->rule->operand == SELECTION_NONTERMINAL_NONE)
+        {
+            defineSelectionConstant(unit, operand);
+        }
+
+        emitSelectionRule(unit, reduction->rule, operand);
     }
-}
\ No newline at end of file
+
+    return true;
+}
+
+void emitAssemblyForFunctionDeclaration(AssemblyUnit *unit, AstFunctionDeclaration *ast)
+{
+    if (!ast->parsed)
+    {
+        return;
+    }
+
+    appendAssemblyBuffer(&unit->text, "\tmov esp, ebp\n\tpop ebp\n\tret\n");
+    writeAssemblyBuffer(&unit->text, unit->cold.data, unit->cold.count);
+    unit->cold.count = 0;
+
+    if (unit->profileMode != PROFILE_MODE_GENERATE)
+    {
+        return;
+    }
+
+    uint64_t key = hashFunctionName(ast->name.lexeme);
+    appendAssemblyBuffer(&unit->bss, "\tprofile_counters_%zu resq %" PRIu32 "\n", unit->currentAst, unit->counterCount);
+    appendAssemblyBuffer(&unit->profileTable, "\tdd 0x%08" PRIX32 ", 0x%08" PRIX32 ", %" PRIu32, (uint32_t)key,
+                         (uint32_t)(key >> 32), unit->counterCount);
+    appendAssemblyBuffer(&unit->profileTable, ", profile_counters_%zu\n", unit->currentAst);
+    unit->functionCount++;
+}
+
+void emitAssemblyForSwitchStatement(AssemblyUnit *unit)
+{
+    AssemblySwitch *frame = getCurrentSwitch(unit);
+
+    if (frame->cold)
+    {
+        if (!frame->terminated)
+        {
+            appendAssemblyBuffer(&unit->text, "\tjmp switch_%zu_%zu_end\n", unit->currentAst, frame->label);
+        }
+
+        swapColdSection(unit, frame);
+    }
+
+    appendAssemblyBuffer(&unit->text, "switch_%zu_%zu_end:\n", unit->currentAst, frame->label);
+    unit->switches.count--;
+}
+
+void emitAssemblyForSwitchDispatch(AssemblyUnit *unit, AssemblySwitch *frame)
+{
+    AstSwitchStatement *ast = frame->statement;
+    bool wide = getTypeSize(unit->types, ast->selector->dataType) == 8;
+
+    frame->dispatched = true;
+    frame->terminated = true;
+
+    if (unit->profileCounters != NULL && ast->caseCount > 0)
+    {
+        emitProfiledSwitchDispatch(unit, frame, wide);
+    }
+    else
+    {
+        emitStaticSwitchDispatch(unit, frame, wide);
+    }
+
+    if (unit->profileMode == PROFILE_MODE_GENERATE && ast->defaultCase == NULL)
+    {
+        appendAssemblyBuffer(&unit->text, "switch_%zu_%zu_miss:\n", unit->currentAst, frame->label);
+        emitProfileCounter(unit, frame->firstCounter + ast->caseCount);
+        appendAssemblyBuffer(&unit->text, "\tjmp switch_%zu_%zu_end\n", unit->currentAst, frame->label);
+    }
+}
+
+void emitAssemblyForCaseLabel(AssemblyUnit *unit, AstCaseLabel *ast)
+{
+    AssemblySwitch *frame = getCurrentSwitch(unit);
+    uint32_t counter = frame->firstCounter + (ast->value != NULL ? ast->index : frame->statement->caseCount);
+
+    if (unit->profileCounters != NULL)
+    {
+        placeCaseBlock(unit, frame, ast, counter);
+    }
+
+    if (unit->profileMode == PROFILE_MODE_GENERATE)
+    {
+        if (!frame->terminated)
+        {
+            appendCaseLabel(unit, frame, ast, "\tjmp ", "_body\n");
+        }
+
+        appendCaseLabel(unit, frame, ast, "", ":\n");
+        emitProfileCounter(unit, counter);
+        appendCaseLabel(unit, frame, ast, "", "_body:\n");
+    }
+    else
+    {
+        appendCaseLabel(unit, frame, ast, "", ":\n");
+    }
+
+    frame->terminated = false;
+}
+
+void emitAssemblyForBreakStatement(AssemblyUnit *unit)
+{
+    AssemblySwitch *frame = getCurrentSwitch(unit);
+    appendAssemblyBuffer(&unit->text, "\tjmp switch_%zu_%zu_end\n", unit->currentAst, frame->label);
+    frame->terminated = true;
+}
+
+SwitchLowering chooseSwitchLowering(const AstSwitchStatement *ast, bool wide)
+{
+    uint64_t count = ast->caseCount;
+
+    if (wide || count == 0)
+    {
+        return SWITCH_LOWERING_LINEAR;
+    }
+
+    uint64_t linearCost = count;
+    uint64_t searchCost = getSwitchSearchCost(count);
+    uint64_t tableCost = getSwitchTableCost(ast);
+
+    if (tableCost < linearCost && tableCost <= searchCost)
+    {
+        return SWITCH_LOWERING_JUMP_TABLE;
+    }
+
+    return searchCost < linearCost ? SWITCH_LOWERING_BINARY_SEARCH : SWITCH_LOWERING_LINEAR;
+}
+
+SwitchLowering chooseProfiledSwitchLowering(const AstSwitchStatement *ast, const uint64_t *counts,
+                                            const uint32_t *order)
+{
+    SwitchLowering lowering = chooseSwitchLowering(ast, false);
+    uint64_t count = ast->caseCount;
+    double total = (double)counts[count];
+    double weighted = (double)counts[count] * (double)count;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        double executions = (double)counts[ast->cases[order[i]]->index];
+        total += executions;
+        weighted += executions * (i + 1);
+    }
+
+    if (total == 0 || lowering == SWITCH_LOWERING_LINEAR)
+    {
+        return lowering;
+    }
+
+    uint64_t cost = lowering == SWITCH_LOWERING_JUMP_TABLE ? getSwitchTableCost(ast) : getSwitchSearchCost(count);
+    return weighted < (double)cost * total ? SWITCH_LOWERING_LINEAR : lowering;
+}
@@ -0,0 +1,148 @@
+#include <bitset.h>
+#include <memory.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static size_t countTrailingZeros(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return index;
+#else
+    size_t count = 0;
+
+    while ((value & 1) == 0)
+    {
+        value >>= 1;
+        count++;
+    }
+
+    return count;
+#endif
+}
+
+void initBitSet(BitSet *set, size_t bitCount)
+{
+    set->bitCount = bitCount;
+    set->wordCount = BITSET_WORDS(bitCount);
+    set->words = set->wordCount > 0 ? ALLOCATE(uint64_t, set->wordCount) : NULL;
+    clearBitSet(set);
+}
+
+void viewBitSet(BitSet *set, uint64_t *words, size_t bitCount)
+{
+    set->bitCount = bitCount;
+    set->wordCount = BITSET_WORDS(bitCount);
+    set->words = words;
+}
+
+void freeBitSet(BitSet *set)
+{
+    FREE(set->words);
+    set->bitCount = 0;
+    set->wordCount = 0;
+    set->words = NULL;
+}
+
+void setBit(BitSet *set, size_t bit)
+{
+    set->words[bit / BITSET_WORD_BITS] |= (uint64_t)1 << (bit % BITSET_WORD_BITS);
+}
+
+void clearBit(BitSet *set, size_t bit)
+{
+    set->words[bit / BITSET_WORD_BITS] &= ~((uint64_t)1 << (bit % BITSET_WORD_BITS));
+}
+
+bool testBit(const BitSet *set, size_t bit)
+{
+    return (set->words[bit / BITSET_WORD_BITS] >> (bit % BITSET_WORD_BITS)) & 1;
+}
+
+void clearBitSet(BitSet *set)
+{
+    if (set->wordCount > 0)
+    {
+        memset(set->words, 0, set->wordCount * sizeof(uint64_t));
+    }
+}
+
+void fillBitSet(BitSet *set)
+{
+    if (set->wordCount == 0)
+    {
+        return;
+    }
+
+    memset(set->words, 0xFF, set->wordCount * sizeof(uint64_t));
+
+    if (set->bitCount % BITSET_WORD_BITS != 0)
+    {
+        set->words[set->wordCount - 1] = ((uint64_t)1 << (set->bitCount % BITSET_WORD_BITS)) - 1;
+    }
+}
+
+void copyBitSet(BitSet *target, const BitSet *source)
+{
+    if (target->wordCount > 0)
+    {
+        memcpy(target->words, source->words, target->wordCount * sizeof(uint64_t));
+    }
+}
+
+bool unionBitSet(BitSet *target, const BitSet *source)
+{
+    uint64_t changed = 0;
+
+    for (size_t i = 0; i < target->wordCount; i++)
+    {
+        uint64_t word = target->words[i] | source->words[i];
+        changed |= word ^ target->words[i];
+        target->words[i] = word;
+    }
+
+    return changed != 0;
+}
+
+bool intersectBitSet(BitSet *target, const BitSet *source)
+{
+    uint64_t changed = 0;
+
+    for (size_t i = 0; i < target->wordCount; i++)
+    {
+        uint64_t word = target->words[i] & source->words[i];
+        changed |= word ^ target->words[i];
+        target->words[i] = word;
+    }
+
+    return changed != 0;
+}
+
+size_t findNextBit(const BitSet *set, size_t from)
+{
+    if (from >= set->bitCount)
+    {
+        return set->bitCount;
+    }
+
+    size_t index = from / BITSET_WORD_BITS;
+    uint64_t word = set->words[index] & (~(uint64_t)0 << (from % BITSET_WORD_BITS));
+
+    while (word == 0)
+    {
+        if (++index >= set->wordCount)
+        {
+            return set->bitCount;
+        }
+
+        word = set->words[index];
+    }
+
+    return index * BITSET_WORD_BITS + countTrailingZeros(word);
+}
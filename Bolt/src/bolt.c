@@ -0,0 +1,120 @@
+#include <bolt.h>
+#include <compiler.h>
+#include <memory.h>
+#include <parallel.h>
+#include <string.h>
+
+struct BoltContext
+{
+    Allocator allocator;
+    bool hasAllocator;
+    uint32_t threadCount;
+    Compiler compiler;
+};
+
+static const Allocator *enterContext(const BoltContext *context)
+{
+    return setAllocator(context->hasAllocator ? &context->allocator : NULL);
+}
+
+BoltContext *boltCreateContext(const BoltAllocator *allocator, uint32_t threadCount)
+{
+    Allocator custom = {NULL, NULL, NULL, NULL};
+
+    if (allocator != NULL)
+    {
+        custom.allocate = allocator->allocate;
+        custom.reallocate = allocator->reallocate;
+        custom.deallocate = allocator->deallocate;
+        custom.userData = allocator->userData;
+    }
+
+    const Allocator *previous = setAllocator(allocator != NULL ? &custom : NULL);
+    BoltContext *context = ALLOCATE(BoltContext, 1);
+
+    if (context != NULL)
+    {
+        context->allocator = custom;
+        context->hasAllocator = allocator != NULL;
+        context->threadCount = threadCount > 0 ? threadCount : (uint32_t)getProcessorCount();
+
+        enterContext(context);
+        initCompiler(&context->compiler);
+        context->compiler.parser.printTrees = false;
+    }
+
+    setAllocator(previous);
+    return context;
+}
+
+void boltDestroyContext(BoltContext *context)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+
+    const Allocator *previous = enterContext(context);
+    freeCompiler(&context->compiler);
+    FREE(context);
+    setAllocator(previous);
+}
+
+BoltStatus boltCompile(BoltContext *context, const char *source, size_t length, BoltOutput *output)
+{
+    const Allocator *previous = enterContext(context);
+    Compiler *compiler = &context->compiler;
+    BoltStatus status = BOLT_STATUS_OK;
+
+    output->data = NULL;
+    output->length = 0;
+
+    resetCompiler(compiler);
+    setCompilerThreadCount(compiler, context->threadCount);
+
+    char *buffer = ALLOCATE(char, length + 1);
+
+    if (buffer == NULL)
+    {
+        strcpy(compiler->error, "Error: Out of memory.");
+        setAllocator(previous);
+        return BOLT_STATUS_ERROR_OUT_OF_MEMORY;
+    }
+
+    memcpy(buffer, source, length);
+    buffer[length] = '\0';
+    compiler->source = buffer;
+    setCompilerSource(compiler, buffer);
+
+    switch (compileCode(compiler))
+    {
+    case COMPILER_STATUS_OK:
+        output->data = compiler->assembler.output.data;
+        output->length = compiler->assembler.output.count;
+        break;
+
+    case COMPILER_STATUS_ERROR_SCAN:
+        status = BOLT_STATUS_ERROR_SCAN;
+        break;
+
+    case COMPILER_STATUS_ERROR_TYPE:
+        status = BOLT_STATUS_ERROR_TYPE;
+        break;
+
+    case COMPILER_STATUS_ERROR_EMIT:
+        status = BOLT_STATUS_ERROR_EMIT;
+        break;
+
+    default:
+        status = BOLT_STATUS_ERROR_PARSE;
+        break;
+    }
+
+    setAllocator(previous);
+    return status;
+}
+
+const char *boltGetError(const BoltContext *context)
+{
+    return context->compiler.error;
+}
@@ -0,0 +1,51 @@
+#ifndef BOLT_H
+#define BOLT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct BoltContext BoltContext;
+
+typedef struct
+{
+    void *(*allocate)(void *userData, size_t size);
+    void *(*reallocate)(void *userData, void *ptr, size_t oldSize, size_t newSize);
+    void (*deallocate)(void *userData, void *ptr);
+    void *userData;
+} BoltAllocator;
+
+typedef enum
+{
+    BOLT_STATUS_OK,
+    BOLT_STATUS_ERROR_OUT_OF_MEMORY,
+    BOLT_STATUS_ERROR_SCAN,
+    BOLT_STATUS_ERROR_PARSE,
+    BOLT_STATUS_ERROR_TYPE,
+    BOLT_STATUS_ERROR_EMIT,
+} BoltStatus;
+
+typedef struct
+{
+    const char *data;
+    size_t length;
+} BoltOutput;
+
+/* allocator may be NULL to use malloc; threadCount 0 uses every processor. With more than one thread the
+   allocator callbacks run concurrently on worker threads, so they must be thread-safe. */
+BoltContext *boltCreateContext(const BoltAllocator *allocator, uint32_t threadCount);
+void boltDestroyContext(BoltContext *context);
+
+/* output points into the context and stays valid until the next boltCompile or boltDestroyContext. */
+BoltStatus boltCompile(BoltContext *context, const char *source, size_t length, BoltOutput *output);
+const char *boltGetError(const BoltContext *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
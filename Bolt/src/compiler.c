@@ -2,16 +2,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdarg.h>
 #include <memory.h>
 
-static const char *readFile(const char *filepath)
+static char *readFile(const char *filepath)
 {
     FILE *file;
     file = fopen(filepath, "r");
 
     if (file == NULL)
     {
-        exit(EXIT_FAILURE);
+        return NULL;
     }
 
     fseek(file, 0, SEEK_END);
@@ -22,35 +23,257 @@ static const char *readFile(const char *filepath)
 
     if (buffer == NULL)
     {
-        fprintf(stderr, "Error to allocate buffer for read file!");
         fclose(file);
         return NULL;
     }
 
-    fread(buffer, sizeof(char), size, file);
-    buffer[size] = '\0';
+    size_t read = fread(buffer, sizeof(char), size, file);
+    buffer[read] = '\0';
     fclose(file);
 
     return buffer;
 }
 
+static CompilerStatus setCompilerError(Compiler *compiler, CompilerStatus status, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vsnprintf(compiler->error, COMPILER_ERROR_SIZE, format, args);
+    va_end(args);
+
+    compiler->status = status;
+    return status;
+}
+
+static const char *getScannerErrorMessage(ScannerStatus status)
+{
+    switch (status)
+    {
+    case SCANNER_STATUS_ERROR_INVALID_CHARACTER:
+        return "Invalid character";
+
+    case SCANNER_STATUS_ERROR_UNTERMINATED_STRING:
+        return "Unterminated string";
+
+    case SCANNER_STATUS_ERROR_INVALID_NUMBER:
+        return "Invalid numeric literal";
+
+    case SCANNER_STATUS_ERROR_UNTERMINATED_COMMENT:
+        return "Unterminated comment";
+
+    default:
+        return "Scanner error";
+    }
+}
+
 void initCompiler(Compiler *compiler)
 {
     initTokenizer(&compiler->tokenizer);
     initParser(&compiler->parser);
-    initAssembler(&compiler->assembler, "C:/Github/CDev/BoltC/test.s");
+    initAnalyzer(&compiler->analyzer);
+    initAssembler(&compiler->assembler);
+    initAstImage(&compiler->image);
+    initPassManager(&compiler->passes);
+    compiler->source = NULL;
+    compiler->outputPath = NULL;
+    compiler->imageOutputPath = NULL;
+    compiler->status = COMPILER_STATUS_OK;
+    compiler->error[0] = '\0';
+}
+
+void resetCompiler(Compiler *compiler)
+{
+    resetTokenizer(&compiler->tokenizer);
+    resetParser(&compiler->parser);
+    resetAnalyzer(&compiler->analyzer);
+    resetAssembler(&compiler->assembler);
+    unloadAstImage(&compiler->image);
+    resetPassManager(&compiler->passes);
+    FREE(compiler->source);
+    compiler->source = NULL;
+    compiler->outputPath = NULL;
+    compiler->imageOutputPath = NULL;
+    compiler->status = COMPILER_STATUS_OK;
+    compiler->error[0] = '\0';
+}
+
+void freeCompiler(Compiler *compiler)
+{
+    freeTokenizer(&compiler->tokenizer);
+    freeParser(&compiler->parser);
+    freeAnalyzer(&compiler->analyzer);
+    freeAssembler(&compiler->assembler);
+    unloadAstImage(&compiler->image);
+    FREE(compiler->source);
+    compiler->source = NULL;
+}
+
+void setCompilerThreadCount(Compiler *compiler, uint32_t threadCount)
+{
+    compiler->tokenizer.threadCount = threadCount;
+    compiler->parser.threadCount = threadCount;
+    compiler->assembler.threadCount = threadCount;
 }
 
-void setCompilerRoot(Compiler *compiler, const char *filepath)
+void setCompilerHashCons(Compiler *compiler, bool hashCons)
 {
-    const char *sourceCode = readFile(filepath);
+    compiler->parser.hashCons = hashCons;
+}
+
+void setCompilerLazyBodies(Compiler *compiler, bool lazyBodies)
+{
+    compiler->parser.lazyBodies = lazyBodies;
+}
+
+void setCompilerOptimizationLevel(Compiler *compiler, OptimizationLevel level)
+{
+    setPassManagerLevel(&compiler->passes, level);
+}
+
+void setCompilerPassStatistics(Compiler *compiler, bool collectStatistics)
+{
+    compiler->passes.collectStatistics = collectStatistics;
+}
+
+bool setCompilerRoot(Compiler *compiler, const char *filepath)
+{
+    char *sourceCode = readFile(filepath);
+
+    if (sourceCode == NULL)
+    {
+        setCompilerError(compiler, COMPILER_STATUS_ERROR_READ_FILE, "Error: Could not read file '%s'.", filepath);
+        return false;
+    }
+
+    FREE(compiler->source);
+    compiler->source = sourceCode;
     setTokenizerSourceCode(&compiler->tokenizer, sourceCode);
+
+    return true;
+}
+
+void setCompilerSource(Compiler *compiler, const char *source)
+{
+    setTokenizerSourceCode(&compiler->tokenizer, source);
 }
 
-void compileCode(Compiler *compiler)
+void setCompilerOutput(Compiler *compiler, const char *outputPath)
 {
-    scanTokens(&compiler->tokenizer);
-    parseTokens(&compiler->parser, &compiler->tokenizer);
+    compiler->outputPath = outputPath;
+}
+
+bool setCompilerImage(Compiler *compiler, const char *imagePath)
+{
+    if (!loadAstImage(&compiler->image, imagePath))
+    {
+        setCompilerError(compiler, COMPILER_STATUS_ERROR_READ_FILE, "Error: Could not load image '%s'.", imagePath);
+        return false;
+    }
+
+    return true;
+}
+
+void setCompilerImageOutput(Compiler *compiler, const char *imagePath)
+{
+    compiler->imageOutputPath = imagePath;
+}
+
+void setCompilerProfileGenerate(Compiler *compiler, const char *profilePath)
+{
+    setAssemblerProfile(&compiler->assembler, PROFILE_MODE_GENERATE, profilePath);
+}
+
+bool setCompilerProfileUse(Compiler *compiler, const char *profilePath)
+{
+    if (!loadProfileData(&compiler->assembler.profile, profilePath))
+    {
+        setCompilerError(compiler, COMPILER_STATUS_ERROR_READ_FILE, "Error: Could not load profile '%s'.", profilePath);
+        return false;
+    }
+
+    setAssemblerProfile(&compiler->assembler, PROFILE_MODE_USE, profilePath);
+    return true;
+}
+
+CompilerStatus compileCode(Compiler *compiler)
+{
+    if (compiler->image.base != NULL)
+    {
+        AstImage *image = &compiler->image;
+
+        if (!adoptParsedTrees(&compiler->parser, image->tokens, image->trees, image->treeCount))
+        {
+            return setCompilerError(compiler, COMPILER_STATUS_ERROR_PARSE, "Error: Invalid expression at line %u.",
+                                    compiler->parser.errorLine);
+        }
+    }
+    else
+    {
+        ScannerStatus scannerStatus = scanTokens(&compiler->tokenizer);
+
+        if (scannerStatus != SCANNER_STATUS_OK)
+        {
+            return setCompilerError(compiler, COMPILER_STATUS_ERROR_SCAN, "Error: %s at line %u.",
+                                    getScannerErrorMessage(scannerStatus), compiler->tokenizer.errorLine);
+        }
+
+        if (!parseTokens(&compiler->parser, &compiler->tokenizer))
+        {
+            return setCompilerError(compiler, COMPILER_STATUS_ERROR_PARSE, "Error: Invalid expression at line %u.",
+                                    compiler->parser.errorLine);
+        }
+    }
+
+    if (compiler->imageOutputPath != NULL &&
+        !saveAstImage(compiler->imageOutputPath, &compiler->parser.tokens, &compiler->parser.trees))
+    {
+        return setCompilerError(compiler, COMPILER_STATUS_ERROR_WRITE_FILE, "Error: Could not write image '%s'.",
+                                compiler->imageOutputPath);
+    }
+
+    PassContext passContext = {&compiler->parser, &compiler->analyzer};
+
+    if (!runPassManager(&compiler->passes, &passContext, PASS_ANALYSIS_TYPES))
+    {
+        return setCompilerError(compiler, COMPILER_STATUS_ERROR_TYPE, "Error: %s at line %u.",
+                                compiler->analyzer.errorMessage, compiler->analyzer.errorLine);
+    }
+
+    if (compiler->passes.collectStatistics)
+    {
+        printPassStatistics(&compiler->passes, stderr);
+    }
+
     setAssemblerAstArray(&compiler->assembler, compiler->parser.trees);
-    emitAssembly(&compiler->assembler);
+    setAssemblerTypeTable(&compiler->assembler, &compiler->analyzer.types);
+
+    if (!emitAssembly(&compiler->assembler))
+    {
+        return setCompilerError(compiler, COMPILER_STATUS_ERROR_EMIT, "Error: Unsupported expression at line %u.",
+                                compiler->assembler.errorLine);
+    }
+
+    if (compiler->outputPath == NULL)
+    {
+        return COMPILER_STATUS_OK;
+    }
+
+    FILE *output = fopen(compiler->outputPath, "w");
+
+    if (output == NULL)
+    {
+        return setCompilerError(compiler, COMPILER_STATUS_ERROR_WRITE_FILE, "Error: Could not open output file '%s'.",
+                                compiler->outputPath);
+    }
+
+    AssemblyBuffer *assembly = &compiler->assembler.output;
+    size_t written = fwrite(assembly->data, sizeof(char), assembly->count, output);
+
+    if (fclose(output) != 0 || written != assembly->count)
+    {
+        return setCompilerError(compiler, COMPILER_STATUS_ERROR_WRITE_FILE, "Error: Could not write output file '%s'.",
+                                compiler->outputPath);
+    }
+
+    return COMPILER_STATUS_OK;
 }
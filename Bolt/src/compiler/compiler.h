@@ -3,17 +3,54 @@
 
 #include <tokenizer.h>
 #include <parsing.h>
+#include <semantic.h>
 #include <assembling.h>
+#include <image.h>
+#include <optimizer.h>
+
+#define COMPILER_ERROR_SIZE 256
+
+typedef enum
+{
+    COMPILER_STATUS_OK,
+    COMPILER_STATUS_ERROR_READ_FILE,
+    COMPILER_STATUS_ERROR_WRITE_FILE,
+    COMPILER_STATUS_ERROR_SCAN,
+    COMPILER_STATUS_ERROR_PARSE,
+    COMPILER_STATUS_ERROR_TYPE,
+    COMPILER_STATUS_ERROR_EMIT,
+} CompilerStatus;
 
 typedef struct
 {
     Tokenizer tokenizer;
     Parser parser;
+    Analyzer analyzer;
     Assembler assembler;
+    AstImage image;
+    PassManager passes;
+    char *source;
+    const char *outputPath;
+    const char *imageOutputPath;
+    CompilerStatus status;
+    char error[COMPILER_ERROR_SIZE];
 } Compiler;
 
 void initCompiler(Compiler *compiler);
-void setCompilerRoot(Compiler *compiler, const char *filepath);
-void compileCode(Compiler *compiler);
+void resetCompiler(Compiler *compiler);
+void freeCompiler(Compiler *compiler);
+void setCompilerThreadCount(Compiler *compiler, uint32_t threadCount);
+void setCompilerHashCons(Compiler *compiler, bool hashCons);
+void setCompilerLazyBodies(Compiler *compiler, bool lazyBodies);
+void setCompilerOptimizationLevel(Compiler *compiler, OptimizationLevel level);
+void setCompilerPassStatistics(Compiler *compiler, bool collectStatistics);
+bool setCompilerRoot(Compiler *compiler, const char *filepath);
+void setCompilerSource(Compiler *compiler, const char *source);
+void setCompilerOutput(Compiler *compiler, const char *outputPath);
+bool setCompilerImage(Compiler *compiler, const char *imagePath);
+void setCompilerImageOutput(Compiler *compiler, const char *imagePath);
+void setCompilerProfileGenerate(Compiler *compiler, const char *profilePath);
+bool setCompilerProfileUse(Compiler *compiler, const char *profilePath);
+CompilerStatus compileCode(Compiler *compiler);
 
-#endif
\ No newline at end of file
+#endif
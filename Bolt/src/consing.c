@@ -0,0 +1,164 @@
+#include <consing.h>
+#include <memory.h>
+#include <string.h>
+
+static uint64_t mixAstHash(uint64_t hash, uint64_t value)
+{
+    hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static uint64_t hashAstString(const char *string)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    while (*string != '\0')
+    {
+        hash ^= (uint8_t)*string++;
+        hash *= 0x100000001B3ull;
+    }
+
+    return hash;
+}
+
+static bool literalEquals(const TokenAttribute *a, const TokenAttribute *b)
+{
+    if (a->type != b->type || a->flags != b->flags)
+    {
+        return false;
+    }
+
+    switch (a->type)
+    {
+    case TOKEN_ATTRIBUTE_TYPE_INT_LITERAL:
+        return a->value.integer == b->value.integer;
+
+    case TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL:
+        return memcmp(&a->value.floating, &b->value.floating, sizeof(double)) == 0;
+
+    case TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL:
+        return strcmp(a->value.string, b->value.string) == 0;
+
+    default:
+        return false;
+    }
+}
+
+static uint64_t hashAstSlot(const void *slot)
+{
+    return (*(Ast *const *)slot)->hash;
+}
+
+void initAstTable(AstTable *table)
+{
+    initHashMap(&table->entries, sizeof(Ast *), AST_TABLE_MIN_CAPACITY, hashAstSlot);
+}
+
+void resetAstTable(AstTable *table)
+{
+    resetHashMap(&table->entries);
+}
+
+void freeAstTable(AstTable *table)
+{
+    freeHashMap(&table->entries);
+}
+
+Ast *findAstTable(AstTable *table, Ast *ast)
+{
+    HashMapProbe probe;
+    Ast **entry;
+
+    startHashMapProbe(&table->entries, ast->hash, &probe);
+
+    while ((entry = nextHashMapMatch(&table->entries, &probe)) != NULL)
+    {
+        if ((*entry)->hash == ast->hash && astEquals(*entry, ast))
+        {
+            return *entry;
+        }
+    }
+
+    return NULL;
+}
+
+void insertAstTable(AstTable *table, Ast *ast)
+{
+    *(Ast **)insertHashMap(&table->entries, ast->hash) = ast;
+}
+
+uint64_t hashLiteralAst(const TokenAttribute *value)
+{
+    uint64_t hash = mixAstHash(AST_TYPE_LITERAL_EXPRESSION_NODE, ((uint64_t)value->type << 8) | value->flags);
+
+    switch (value->type)
+    {
+    case TOKEN_ATTRIBUTE_TYPE_INT_LITERAL:
+        return mixAstHash(hash, value->value.integer);
+
+    case TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL:
+    {
+        uint64_t bits;
+        memcpy(&bits, &value->value.floating, sizeof(bits));
+        return mixAstHash(hash, bits);
+    }
+
+    case TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL:
+        return mixAstHash(hash, hashAstString(value->value.string));
+
+    default:
+        return hash;
+    }
+}
+
+uint64_t hashUnaryAst(TokenType op, const Ast *right)
+{
+    return mixAstHash(mixAstHash(AST_TYPE_UNARY_EXPRESSION_NODE, op), right->hash);
+}
+
+bool isAstConsable(const Ast *ast)
+{
+    switch (ast->type)
+    {
+    case AST_TYPE_LITERAL_EXPRESSION_NODE:
+        return ((const AstLiteralExpression *)ast)->value.type != TOKEN_ATTRIBUTE_TYPE_NULL_ATTRIBUTE;
+
+    case AST_TYPE_UNARY_EXPRESSION_NODE:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+bool astEquals(const Ast *a, const Ast *b)
+{
+    if (a == b)
+    {
+        return true;
+    }
+
+    if (a->type != b->type || a->hash != b->hash)
+    {
+        return false;
+    }
+
+    switch (a->type)
+    {
+    case AST_TYPE_LITERAL_EXPRESSION_NODE:
+        return literalEquals(&((const AstLiteralExpression *)a)->value, &((const AstLiteralExpression *)b)->value);
+
+    case AST_TYPE_UNARY_EXPRESSION_NODE:
+    {
+        const AstUnaryExpression *left = (const AstUnaryExpression *)a;
+        const AstUnaryExpression *right = (const AstUnaryExpression *)b;
+        return left->op == right->op && left->right == right->right;
+    }
+
+    default:
+        return false;
+    }
+}
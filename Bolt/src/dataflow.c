@@ -0,0 +1,418 @@
+#include <dataflow.h>
+#include <memory.h>
+#include <array.h>
+#include <string.h>
+
+static uint32_t addFlowBlock(FlowGraph *graph, uint32_t region, uint32_t start)
+{
+    if (graph->blockCount >= graph->blockCapacity)
+    {
+        uint32_t oldCapacity = graph->blockCapacity;
+        uint32_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
+
+        graph->blocks = REALLOCATE(FlowBlock, graph->blocks, oldCapacity, newCapacity);
+        graph->order = REALLOCATE(uint32_t, graph->order, oldCapacity, newCapacity);
+        graph->position = REALLOCATE(uint32_t, graph->position, oldCapacity, newCapacity);
+        graph->cursor = REALLOCATE(uint32_t, graph->cursor, oldCapacity, newCapacity);
+        graph->blockCapacity = newCapacity;
+    }
+
+    FlowBlock *block = &graph->blocks[graph->blockCount];
+    block->region = region;
+    block->start = start;
+    block->count = 0;
+    block->firstSuccessor = 0;
+    block->successorCount = 0;
+    block->firstPredecessor = 0;
+    block->predecessorCount = 0;
+
+    return graph->blockCount++;
+}
+
+static void addFlowEdge(FlowGraph *graph, uint32_t from, uint32_t to)
+{
+    if (graph->edgeCount >= graph->edgeCapacity)
+    {
+        uint32_t oldCapacity = graph->edgeCapacity;
+        uint32_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
+
+        graph->edges = REALLOCATE(FlowEdge, graph->edges, oldCapacity, newCapacity);
+        graph->successors = REALLOCATE(uint32_t, graph->successors, oldCapacity, newCapacity);
+        graph->predecessors = REALLOCATE(uint32_t, graph->predecessors, oldCapacity, newCapacity);
+        graph->edgeCapacity = newCapacity;
+    }
+
+    graph->edges[graph->edgeCount++] = (FlowEdge){from, to};
+    graph->blocks[from].successorCount++;
+    graph->blocks[to].predecessorCount++;
+}
+
+static uint32_t addFlowRegion(FlowGraph *graph, Ast *owner, Ast **body, uint32_t count)
+{
+    if (graph->regionCount >= graph->regionCapacity)
+    {
+        uint32_t oldCapacity = graph->regionCapacity;
+        uint32_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
+
+        graph->regions = REALLOCATE(FlowRegion, graph->regions, oldCapacity, newCapacity);
+        graph->regionCapacity = newCapacity;
+    }
+
+    graph->regions[graph->regionCount] = (FlowRegion){owner, body, count};
+    return graph->regionCount++;
+}
+
+static FlowFrame *pushFlowFrame(FlowGraph *graph)
+{
+    if (graph->frameCount >= graph->frameCapacity)
+    {
+        uint32_t oldCapacity = graph->frameCapacity;
+        uint32_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
+
+        graph->frames = REALLOCATE(FlowFrame, graph->frames, oldCapacity, newCapacity);
+        graph->frameCapacity = newCapacity;
+    }
+
+    return &graph->frames[graph->frameCount++];
+}
+
+static void linkFlowEdges(FlowGraph *graph)
+{
+    uint32_t successorOffset = 0;
+    uint32_t predecessorOffset = 0;
+
+    for (uint32_t i = 0; i < graph->blockCount; i++)
+    {
+        FlowBlock *block = &graph->blocks[i];
+        block->firstSuccessor = successorOffset;
+        block->firstPredecessor = predecessorOffset;
+        successorOffset += block->successorCount;
+        predecessorOffset += block->predecessorCount;
+        block->successorCount = 0;
+        block->predecessorCount = 0;
+    }
+
+    for (uint32_t i = 0; i < graph->edgeCount; i++)
+    {
+        FlowBlock *from = &graph->blocks[graph->edges[i].from];
+        FlowBlock *to = &graph->blocks[graph->edges[i].to];
+
+        graph->successors[from->firstSuccessor + from->successorCount++] = graph->edges[i].to;
+        graph->predecessors[to->firstPredecessor + to->predecessorCount++] = graph->edges[i].from;
+    }
+}
+
+static void orderFlowBlocks(FlowGraph *graph)
+{
+    uint32_t *stack = graph->position;
+    uint32_t *visited = graph->cursor;
+    uint32_t depth = 0;
+
+    graph->orderCount = 0;
+    memset(visited, 0, graph->blockCount * sizeof(uint32_t));
+
+    stack[depth++] = 0;
+    visited[0] = 1;
+
+    while (depth > 0)
+    {
+        uint32_t index = stack[depth - 1];
+        FlowBlock *block = &graph->blocks[index];
+        uint32_t next = visited[index] - 1;
+
+        if (next == block->successorCount)
+        {
+            graph->order[graph->orderCount++] = index;
+            depth--;
+            continue;
+        }
+
+        visited[index]++;
+        uint32_t successor = graph->successors[block->firstSuccessor + next];
+
+        if (visited[successor] == 0)
+        {
+            visited[successor] = 1;
+            stack[depth++] = successor;
+        }
+    }
+
+    for (uint32_t i = 0; i < graph->orderCount / 2; i++)
+    {
+        uint32_t swap = graph->order[i];
+        graph->order[i] = graph->order[graph->orderCount - 1 - i];
+        graph->order[graph->orderCount - 1 - i] = swap;
+    }
+
+    for (uint32_t i = 0; i < graph->blockCount; i++)
+    {
+        graph->position[i] = FLOW_BLOCK_NONE;
+    }
+
+    for (uint32_t i = 0; i < graph->orderCount; i++)
+    {
+        graph->position[graph->order[i]] = i;
+    }
+}
+
+static bool transferBitSet(BitSet *output, const BitSet *gen, const BitSet *input, const BitSet *kill)
+{
+    uint64_t changed = 0;
+
+    for (size_t i = 0; i < output->wordCount; i++)
+    {
+        uint64_t word = gen->words[i] | (input->words[i] & ~kill->words[i]);
+        changed |= word ^ output->words[i];
+        output->words[i] = word;
+    }
+
+    return changed != 0;
+}
+
+void initFlowGraph(FlowGraph *graph)
+{
+    graph->blockCount = 0;
+    graph->blockCapacity = MIN_ARRAY_SIZE;
+    graph->blocks = ALLOCATE(FlowBlock, MIN_ARRAY_SIZE);
+    graph->order = ALLOCATE(uint32_t, MIN_ARRAY_SIZE);
+    graph->position = ALLOCATE(uint32_t, MIN_ARRAY_SIZE);
+    graph->cursor = ALLOCATE(uint32_t, MIN_ARRAY_SIZE);
+    graph->orderCount = 0;
+    graph->edgeCount = 0;
+    graph->edgeCapacity = MIN_ARRAY_SIZE;
+    graph->edges = ALLOCATE(FlowEdge, MIN_ARRAY_SIZE);
+    graph->successors = ALLOCATE(uint32_t, MIN_ARRAY_SIZE);
+    graph->predecessors = ALLOCATE(uint32_t, MIN_ARRAY_SIZE);
+    graph->regionCount = 0;
+    graph->regionCapacity = MIN_ARRAY_SIZE;
+    graph->regions = ALLOCATE(FlowRegion, MIN_ARRAY_SIZE);
+    graph->frameCount = 0;
+    graph->frameCapacity = MIN_ARRAY_SIZE;
+    graph->frames = ALLOCATE(FlowFrame, MIN_ARRAY_SIZE);
+}
+
+void buildFlowGraph(FlowGraph *graph, AstFunctionDeclaration *function)
+{
+    graph->blockCount = 0;
+    graph->edgeCount = 0;
+    graph->regionCount = 0;
+    graph->frameCount = 0;
+
+    uint32_t region = addFlowRegion(graph, (Ast *)function, function->body, function->bodyCount);
+    FlowFrame *root = pushFlowFrame(graph);
+    *root = (FlowFrame){region, 0, addFlowBlock(graph, region, 0), FLOW_BLOCK_NONE, FLOW_BLOCK_NONE};
+
+    while (graph->frameCount > 0)
+    {
+        FlowFrame *frame = &graph->frames[graph->frameCount - 1];
+        FlowRegion *current = &graph->regions[frame->region];
+
+        if (frame->index == current->count)
+        {
+            if (frame->exit != FLOW_BLOCK_NONE)
+            {
+                addFlowEdge(graph, frame->current, frame->exit);
+            }
+
+            graph->frameCount--;
+            continue;
+        }
+
+        uint32_t index = frame->index++;
+        Ast *ast = current->body[index];
+
+        switch (ast->type)
+        {
+        case AST_TYPE_CASE_LABEL_NODE:
+        {
+            uint32_t block = addFlowBlock(graph, frame->region, index);
+            addFlowEdge(graph, frame->current, block);
+            addFlowEdge(graph, frame->dispatch, block);
+            graph->blocks[block].count++;
+            frame->current = block;
+            break;
+        }
+
+        case AST_TYPE_BREAK_STATEMENT_NODE:
+            graph->blocks[frame->current].count++;
+            addFlowEdge(graph, frame->current, frame->exit);
+            frame->current = addFlowBlock(graph, frame->region, index + 1);
+            break;
+
+        case AST_TYPE_SWITCH_STATEMENT_NODE:
+        {
+            AstSwitchStatement *statement = (AstSwitchStatement *)ast;
+            uint32_t dispatch = frame->current;
+            uint32_t exit = addFlowBlock(graph, frame->region, index + 1);
+
+            graph->blocks[dispatch].count++;
+            frame->current = exit;
+
+            if (statement->defaultCase == NULL)
+            {
+                addFlowEdge(graph, dispatch, exit);
+            }
+
+            uint32_t body = addFlowRegion(graph, ast, statement->body, statement->bodyCount);
+            FlowFrame *child = pushFlowFrame(graph);
+            *child = (FlowFrame){body, 0, addFlowBlock(graph, body, 0), dispatch, exit};
+            break;
+        }
+
+        default:
+            graph->blocks[frame->current].count++;
+            break;
+        }
+    }
+
+    linkFlowEdges(graph);
+    orderFlowBlocks(graph);
+}
+
+void freeFlowGraph(FlowGraph *graph)
+{
+    FREE(graph->blocks);
+    FREE(graph->order);
+    FREE(graph->position);
+    FREE(graph->cursor);
+    FREE(graph->edges);
+    FREE(graph->successors);
+    FREE(graph->predecessors);
+    FREE(graph->regions);
+    FREE(graph->frames);
+    graph->blocks = NULL;
+    graph->blockCount = 0;
+    graph->blockCapacity = 0;
+    graph->orderCount = 0;
+    graph->edgeCount = 0;
+    graph->edgeCapacity = 0;
+    graph->regionCount = 0;
+    graph->regionCapacity = 0;
+    graph->frameCount = 0;
+    graph->frameCapacity = 0;
+}
+
+void initDataflowProblem(DataflowProblem *problem, const FlowGraph *graph, DataflowDirection direction,
+                         DataflowMeet meet, size_t bitCount)
+{
+    size_t wordCount = BITSET_WORDS(bitCount);
+    size_t setCount = (size_t)graph->blockCount * 4 + 1;
+
+    problem->direction = direction;
+    problem->meet = meet;
+    problem->blockCount = graph->blockCount;
+    problem->gen = ALLOCATE(BitSet, (size_t)graph->blockCount * 4);
+    problem->kill = problem->gen + graph->blockCount;
+    problem->in = problem->kill + graph->blockCount;
+    problem->out = problem->in + graph->blockCount;
+    problem->words = wordCount > 0 ? ALLOCATE(uint64_t, setCount * wordCount) : NULL;
+
+    if (problem->words != NULL)
+    {
+        memset(problem->words, 0, setCount * wordCount * sizeof(uint64_t));
+    }
+
+    for (size_t i = 0; i < (size_t)graph->blockCount * 4; i++)
+    {
+        viewBitSet(&problem->gen[i], problem->words != NULL ? problem->words + i * wordCount : NULL, bitCount);
+    }
+
+    viewBitSet(&problem->boundary, problem->words != NULL ? problem->words + (setCount - 1) * wordCount : NULL,
+               bitCount);
+}
+
+void solveDataflowProblem(DataflowProblem *problem, const FlowGraph *graph)
+{
+    bool forward = problem->direction == DATAFLOW_DIRECTION_FORWARD;
+    bool intersect = problem->meet == DATAFLOW_MEET_INTERSECTION;
+    BitSet pending;
+
+    for (uint32_t i = 0; intersect && i < problem->blockCount; i++)
+    {
+        fillBitSet(&problem->in[i]);
+        fillBitSet(&problem->out[i]);
+    }
+
+    initBitSet(&pending, graph->orderCount);
+    fillBitSet(&pending);
+
+    for (size_t next = 0;;)
+    {
+        size_t position = findNextBit(&pending, next);
+
+        if (position == graph->orderCount && (position = findNextBit(&pending, 0)) == graph->orderCount)
+        {
+            break;
+        }
+
+        clearBit(&pending, position);
+        next = position + 1;
+
+        uint32_t index = graph->order[forward ? position : graph->orderCount - 1 - position];
+        const FlowBlock *block = &graph->blocks[index];
+        BitSet *input = forward ? &problem->in[index] : &problem->out[index];
+        BitSet *output = forward ? &problem->out[index] : &problem->in[index];
+        const uint32_t *sources = forward ? graph->predecessors + block->firstPredecessor
+                                          : graph->successors + block->firstSuccessor;
+        uint32_t sourceCount = forward ? block->predecessorCount : block->successorCount;
+        const uint32_t *targets = forward ? graph->successors + block->firstSuccessor
+                                          : graph->predecessors + block->firstPredecessor;
+        uint32_t targetCount = forward ? block->successorCount : block->predecessorCount;
+
+        if (forward ? index == 0 : block->successorCount == 0)
+        {
+            copyBitSet(input, &problem->boundary);
+        }
+        else if (intersect)
+        {
+            fillBitSet(input);
+        }
+        else
+        {
+            clearBitSet(input);
+        }
+
+        for (uint32_t i = 0; i < sourceCount; i++)
+        {
+            const BitSet *source = forward ? &problem->out[sources[i]] : &problem->in[sources[i]];
+
+            if (intersect)
+            {
+                intersectBitSet(input, source);
+            }
+            else
+            {
+                unionBitSet(input, source);
+            }
+        }
+
+        if (!transferBitSet(output, &problem->gen[index], input, &problem->kill[index]))
+        {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < targetCount; i++)
+        {
+            uint32_t target = graph->position[targets[i]];
+
+            if (target != FLOW_BLOCK_NONE)
+            {
+                setBit(&pending, forward ? target : graph->orderCount - 1 - target);
+            }
+        }
+    }
+
+    freeBitSet(&pending);
+}
+
+void freeDataflowProblem(DataflowProblem *problem)
+{
+    FREE(problem->gen);
+    FREE(problem->words);
+    problem->gen = NULL;
+    problem->kill = NULL;
+    problem->in = NULL;
+    problem->out = NULL;
+    problem->words = NULL;
+    problem->blockCount = 0;
+}
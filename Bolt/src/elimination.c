@@ -0,0 +1,93 @@
+#include <elimination.h>
+#include <dataflow.h>
+
+static void compactFlowRegion(FlowRegion *region)
+{
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < region->count; i++)
+    {
+        if (region->body[i] != NULL)
+        {
+            region->body[count++] = region->body[i];
+        }
+    }
+
+    if (region->owner->type == AST_TYPE_SWITCH_STATEMENT_NODE)
+    {
+        ((AstSwitchStatement *)region->owner)->bodyCount = count;
+    }
+    else
+    {
+        ((AstFunctionDeclaration *)region->owner)->bodyCount = count;
+    }
+}
+
+static size_t eliminateFunctionCode(FlowGraph *graph, AstFunctionDeclaration *function)
+{
+    buildFlowGraph(graph, function);
+
+    if (graph->orderCount == graph->blockCount)
+    {
+        return 0;
+    }
+
+    DataflowProblem reachable;
+    BitSet dirty;
+    size_t removed = 0;
+
+    initDataflowProblem(&reachable, graph, DATAFLOW_DIRECTION_FORWARD, DATAFLOW_MEET_UNION, 1);
+    setBit(&reachable.boundary, 0);
+    solveDataflowProblem(&reachable, graph);
+    initBitSet(&dirty, graph->regionCount);
+
+    for (uint32_t i = 0; i < graph->blockCount; i++)
+    {
+        FlowBlock *block = &graph->blocks[i];
+
+        if (block->count == 0 || testBit(&reachable.in[i], 0))
+        {
+            continue;
+        }
+
+        FlowRegion *region = &graph->regions[block->region];
+
+        for (uint32_t j = 0; j < block->count; j++)
+        {
+            region->body[block->start + j] = NULL;
+        }
+
+        setBit(&dirty, block->region);
+        removed += block->count;
+    }
+
+    for (size_t i = findNextBit(&dirty, 0); i < graph->regionCount; i = findNextBit(&dirty, i + 1))
+    {
+        compactFlowRegion(&graph->regions[i]);
+    }
+
+    freeBitSet(&dirty);
+    freeDataflowProblem(&reachable);
+    return removed;
+}
+
+size_t eliminateUnreachableCode(Parser *parser)
+{
+    FlowGraph graph;
+    size_t removed = 0;
+
+    initFlowGraph(&graph);
+
+    for (size_t i = 0; i < parser->trees.count; i++)
+    {
+        Ast *ast = parser->trees.trees[i];
+
+        if (ast->type == AST_TYPE_FUNCTION_DECLARATION_NODE && ((AstFunctionDeclaration *)ast)->bodyCount > 0)
+        {
+            removed += eliminateFunctionCode(&graph, (AstFunctionDeclaration *)ast);
+        }
+    }
+
+    freeFlowGraph(&graph);
+    return removed;
+}
@@ -0,0 +1,163 @@
+#include <folding.h>
+#include <consing.h>
+#include <walker.h>
+
+typedef struct
+{
+    Parser *parser;
+    const TypeTable *types;
+    size_t folded;
+} ConstantFolder;
+
+static void foldSlot(ConstantFolder *folder, Ast **slot)
+{
+    if ((*slot)->type != AST_TYPE_UNARY_EXPRESSION_NODE)
+    {
+        return;
+    }
+
+    Ast *folded = foldUnaryExpression(folder->parser, folder->types, (AstUnaryExpression *)*slot);
+
+    if (folded != NULL)
+    {
+        *slot = folded;
+        folder->folded++;
+    }
+}
+
+static AstWalkAction foldChildren(Ast *ast, void *context)
+{
+    ConstantFolder *folder = context;
+
+    switch (ast->type)
+    {
+    case AST_TYPE_UNARY_EXPRESSION_NODE:
+        foldSlot(folder, &((AstUnaryExpression *)ast)->right);
+        break;
+
+    case AST_TYPE_FUNCTION_DECLARATION_NODE:
+    {
+        AstFunctionDeclaration *function = (AstFunctionDeclaration *)ast;
+
+        for (uint32_t i = 0; i < function->bodyCount; i++)
+        {
+            foldSlot(folder, &function->body[i]);
+        }
+
+        break;
+    }
+
+    case AST_TYPE_SWITCH_STATEMENT_NODE:
+    {
+        AstSwitchStatement *statement = (AstSwitchStatement *)ast;
+        foldSlot(folder, &statement->selector);
+
+        for (uint32_t i = 0; i < statement->bodyCount; i++)
+        {
+            foldSlot(folder, &statement->body[i]);
+        }
+
+        break;
+    }
+
+    case AST_TYPE_CASE_LABEL_NODE:
+        if (((AstCaseLabel *)ast)->value != NULL)
+        {
+            foldSlot(folder, &((AstCaseLabel *)ast)->value);
+        }
+
+        break;
+
+    default:
+        break;
+    }
+
+    return AST_WALK_CONTINUE;
+}
+
+size_t foldConstants(Parser *parser, const TypeTable *types)
+{
+    ConstantFolder folder = {parser, types, 0};
+    AstVisitor visitor = {NULL, foldChildren};
+    AstWalker walker;
+
+    initAstWalker(&walker);
+
+    for (size_t i = 0; i < parser->trees.count; i++)
+    {
+        walkAst(&walker, parser->trees.trees[i], &visitor, &folder);
+        foldSlot(&folder, &parser->trees.trees[i]);
+    }
+
+    freeAstWalker(&walker);
+    return folder.folded;
+}
+
+Ast *foldUnaryExpression(Parser *parser, const TypeTable *types, AstUnaryExpression *ast)
+{
+    if (ast->info.dataType == TYPE_ID_INVALID || ast->right->type != AST_TYPE_LITERAL_EXPRESSION_NODE)
+    {
+        return NULL;
+    }
+
+    TokenAttribute value = ((AstLiteralExpression *)ast->right)->value;
+
+    switch (ast->op)
+    {
+    case TOKEN_TYPE_MINUS:
+        if (value.type == TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL)
+        {
+            value.value.floating = -value.value.floating;
+        }
+        else if (value.type == TOKEN_ATTRIBUTE_TYPE_INT_LITERAL)
+        {
+            value.value.integer = truncateIntegerValue(types, ast->info.dataType, 0 - value.value.integer);
+        }
+        else
+        {
+            return NULL;
+        }
+
+        break;
+
+    case TOKEN_TYPE_LOGICAL_NOT:
+    {
+        bool zero;
+
+        switch (value.type)
+        {
+        case TOKEN_ATTRIBUTE_TYPE_INT_LITERAL:
+            zero = value.value.integer == 0;
+            break;
+
+        case TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL:
+            zero = value.value.floating == 0.0;
+            break;
+
+        case TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL:
+            zero = false;
+            break;
+
+        default:
+            return NULL;
+        }
+
+        value.type = TOKEN_ATTRIBUTE_TYPE_INT_LITERAL;
+        value.flags = TOKEN_LITERAL_FLAG_NONE;
+        value.value.integer = zero ? 1 : 0;
+        break;
+    }
+
+    default:
+        return NULL;
+    }
+
+    AstLiteralExpression *literal = ARENA_ALLOCATE(&parser->arena, AstLiteralExpression, 1);
+    literal->info.type = AST_TYPE_LITERAL_EXPRESSION_NODE;
+    literal->info.line = ast->info.line;
+    literal->info.hash = hashLiteralAst(&value);
+    literal->info.dataType = ast->info.dataType;
+    literal->value = value;
+
+    return (Ast *)literal;
+}
@@ -0,0 +1,223 @@
+#include <hashmap.h>
+#include <memory.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASH_MAP_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static uint32_t countTrailingZeros(uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(value);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return index;
+#else
+    uint32_t count = 0;
+
+    while ((value & 1) == 0)
+    {
+        value >>= 1;
+        count++;
+    }
+
+    return count;
+#endif
+}
+
+static uint32_t matchHashMapTag(const uint8_t *group, uint8_t tag)
+{
+#ifdef HASH_MAP_SSE2
+    __m128i control = _mm_loadu_si128((const __m128i *)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)tag)));
+#else
+    uint32_t mask = 0;
+
+    for (uint32_t i = 0; i < HASH_MAP_GROUP_SIZE; i++)
+    {
+        mask |= (uint32_t)(group[i] == tag) << i;
+    }
+
+    return mask;
+#endif
+}
+
+static uint32_t matchHashMapEmpty(const uint8_t *group)
+{
+#ifdef HASH_MAP_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+    uint32_t mask = 0;
+
+    for (uint32_t i = 0; i < HASH_MAP_GROUP_SIZE; i++)
+    {
+        mask |= (uint32_t)(group[i] >> 7) << i;
+    }
+
+    return mask;
+#endif
+}
+
+static void setHashMapControl(HashMap *map, size_t index, uint8_t value)
+{
+    map->control[index] = value;
+
+    if (index < HASH_MAP_GROUP_SIZE)
+    {
+        map->control[map->capacity + index] = value;
+    }
+}
+
+static size_t findHashMapEmpty(const HashMap *map, uint64_t hash)
+{
+    size_t mask = map->capacity - 1;
+    size_t position = (size_t)(hash >> 7) & mask;
+
+    for (size_t stride = HASH_MAP_GROUP_SIZE;; stride += HASH_MAP_GROUP_SIZE)
+    {
+        uint32_t empties = matchHashMapEmpty(map->control + position);
+
+        if (empties != 0)
+        {
+            return (position + countTrailingZeros(empties)) & mask;
+        }
+
+        position = (position + stride) & mask;
+    }
+}
+
+static void allocateHashMap(HashMap *map, size_t capacity)
+{
+    map->count = 0;
+    map->capacity = capacity;
+    map->control = ALLOCATE(uint8_t, capacity + HASH_MAP_GROUP_SIZE);
+    map->slots = ALLOCATE(char, capacity * map->slotSize);
+    memset(map->control, HASH_MAP_CONTROL_EMPTY, capacity + HASH_MAP_GROUP_SIZE);
+}
+
+static void rehashHashMap(HashMap *map, size_t capacity)
+{
+    uint8_t *oldControl = map->control;
+    char *oldSlots = map->slots;
+    size_t oldCapacity = map->capacity;
+    size_t count = map->count;
+
+    allocateHashMap(map, capacity);
+
+    for (size_t i = 0; i < oldCapacity; i++)
+    {
+        if (oldControl[i] == HASH_MAP_CONTROL_EMPTY)
+        {
+            continue;
+        }
+
+        const char *slot = oldSlots + i * map->slotSize;
+        uint64_t hash = map->hash(slot);
+        size_t index = findHashMapEmpty(map, hash);
+
+        setHashMapControl(map, index, (uint8_t)(hash & 0x7F));
+        memcpy(map->slots + index * map->slotSize, slot, map->slotSize);
+    }
+
+    map->count = count;
+    FREE(oldControl);
+    FREE(oldSlots);
+}
+
+void initHashMap(HashMap *map, size_t slotSize, size_t capacity, HashMapHashFunction hash)
+{
+    size_t size = HASH_MAP_MIN_CAPACITY;
+
+    while (size < capacity)
+    {
+        size *= ARRAY_GROW_FACTOR;
+    }
+
+    map->slotSize = slotSize;
+    map->hash = hash;
+    allocateHashMap(map, size);
+}
+
+void resetHashMap(HashMap *map)
+{
+    if (map->count > 0)
+    {
+        memset(map->control, HASH_MAP_CONTROL_EMPTY, map->capacity + HASH_MAP_GROUP_SIZE);
+        map->count = 0;
+    }
+}
+
+void freeHashMap(HashMap *map)
+{
+    FREE(map->control);
+    FREE(map->slots);
+    map->control = NULL;
+    map->slots = NULL;
+    map->count = 0;
+    map->capacity = 0;
+}
+
+void reserveHashMap(HashMap *map, size_t count)
+{
+    size_t capacity = map->capacity;
+
+    while (count * HASH_MAP_MAX_LOAD_DENOMINATOR > capacity * HASH_MAP_MAX_LOAD_NUMERATOR)
+    {
+        capacity *= ARRAY_GROW_FACTOR;
+    }
+
+    if (capacity != map->capacity)
+    {
+        rehashHashMap(map, capacity);
+    }
+}
+
+void startHashMapProbe(const HashMap *map, uint64_t hash, HashMapProbe *probe)
+{
+    probe->position = (size_t)(hash >> 7) & (map->capacity - 1);
+    probe->stride = 0;
+    probe->tag = (uint8_t)(hash & 0x7F);
+    probe->matches = matchHashMapTag(map->control + probe->position, probe->tag);
+    probe->last = matchHashMapEmpty(map->control + probe->position) != 0;
+}
+
+void *nextHashMapMatch(const HashMap *map, HashMapProbe *probe)
+{
+    size_t mask = map->capacity - 1;
+
+    while (probe->matches == 0)
+    {
+        if (probe->last)
+        {
+            return NULL;
+        }
+
+        probe->stride += HASH_MAP_GROUP_SIZE;
+        probe->position = (probe->position + probe->stride) & mask;
+        probe->matches = matchHashMapTag(map->control + probe->position, probe->tag);
+        probe->last = matchHashMapEmpty(map->control + probe->position) != 0;
+    }
+
+    size_t index = (probe->position + countTrailingZeros(probe->matches)) & mask;
+    probe->matches &= probe->matches - 1;
+
+    return map->slots + index * map->slotSize;
+}
+
+void *insertHashMap(HashMap *map, uint64_t hash)
+{
+    reserveHashMap(map, map->count + 1);
+
+    size_t index = findHashMapEmpty(map, hash);
+    setHashMapControl(map, index, (uint8_t)(hash & 0x7F));
+    map->count++;
+
+    return map->slots + index * map->slotSize;
+}
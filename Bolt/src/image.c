@@ -0,0 +1,823 @@
+#include <image.h>
+#include <walker.h>
+#include <memory.h>
+#include <array.h>
+#include <hashmap.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+typedef struct
+{
+    size_t count;
+    size_t capacity;
+    char *data;
+} ImageBuffer;
+
+typedef struct
+{
+    Ast *ast;
+    uint64_t offset;
+} ImageNodeEntry;
+
+typedef struct
+{
+    ImageBuffer nodes;
+    ImageBuffer strings;
+    ImageBuffer index;
+    HashMap entries;
+    uint64_t nodesOffset;
+    bool failed;
+} ImageWriter;
+
+static size_t alignImageOffset(size_t offset)
+{
+    return (offset + AST_IMAGE_ALIGNMENT - 1) & ~(size_t)(AST_IMAGE_ALIGNMENT - 1);
+}
+
+static void initImageBuffer(ImageBuffer *buffer)
+{
+    buffer->count = 0;
+    buffer->capacity = MIN_ARRAY_SIZE;
+    buffer->data = ALLOCATE(char, MIN_ARRAY_SIZE);
+}
+
+static void freeImageBuffer(ImageBuffer *buffer)
+{
+    FREE(buffer->data);
+    buffer->data = NULL;
+    buffer->count = 0;
+    buffer->capacity = 0;
+}
+
+static size_t writeImageBuffer(ImageBuffer *buffer, const void *data, size_t size)
+{
+    size_t offset = alignImageOffset(buffer->count);
+
+    if (offset + size > buffer->capacity)
+    {
+        size_t oldCapacity = buffer->capacity;
+        size_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
+
+        while (newCapacity < offset + size)
+        {
+            newCapacity *= ARRAY_GROW_FACTOR;
+        }
+
+        buffer->data = REALLOCATE(char, buffer->data, oldCapacity, newCapacity);
+        buffer->capacity = newCapacity;
+    }
+
+    memset(buffer->data + buffer->count, 0, offset - buffer->count);
+    memcpy(buffer->data + offset, data, size);
+    buffer->count = offset + size;
+
+    return offset;
+}
+
+static uintptr_t addImageString(ImageWriter *writer, const char *string)
+{
+    if (string == NULL)
+    {
+        return 0;
+    }
+
+    ImageBuffer *strings = &writer->strings;
+    size_t length = strlen(string) + 1;
+
+    if (strings->count + length > strings->capacity)
+    {
+        size_t oldCapacity = strings->capacity;
+        size_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
+
+        while (newCapacity < strings->count + length)
+        {
+            newCapacity *= ARRAY_GROW_FACTOR;
+        }
+
+        strings->data = REALLOCATE(char, strings->data, oldCapacity, newCapacity);
+        strings->capacity = newCapacity;
+    }
+
+    uintptr_t reference = (uintptr_t)strings->count + 1;
+    memcpy(strings->data + strings->count, string, length);
+    strings->count += length;
+
+    return reference;
+}
+
+static uint64_t hashImagePointer(const Ast *ast)
+{
+    uint64_t hash = (uint64_t)(uintptr_t)ast;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static uint64_t hashImageNode(const void *slot)
+{
+    return hashImagePointer(((const ImageNodeEntry *)slot)->ast);
+}
+
+static ImageNodeEntry *findImageNode(ImageWriter *writer, const Ast *ast)
+{
+    HashMapProbe probe;
+    ImageNodeEntry *entry;
+
+    startHashMapProbe(&writer->entries, hashImagePointer(ast), &probe);
+
+    while ((entry = nextHashMapMatch(&writer->entries, &probe)) != NULL)
+    {
+        if (entry->ast == ast)
+        {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static void addImageNode(ImageWriter *writer, Ast *ast, uint64_t offset)
+{
+    ImageNodeEntry *entry = insertHashMap(&writer->entries, hashImagePointer(ast));
+    entry->ast = ast;
+    entry->offset = offset;
+    writeImageBuffer(&writer->index, &offset, sizeof(offset));
+}
+
+static uintptr_t getImageNodeOffset(ImageWriter *writer, const Ast *ast)
+{
+    return ast != NULL ? (uintptr_t)findImageNode(writer, ast)->offset : 0;
+}
+
+static AstWalkAction enterImageNode(Ast *ast, void *context)
+{
+    ImageWriter *writer = context;
+    return findImageNode(writer, ast) != NULL ? AST_WALK_SKIP_CHILDREN : AST_WALK_CONTINUE;
+}
+
+static AstWalkAction writeImageNode(Ast *ast, void *context)
+{
+    ImageWriter *writer = context;
+
+    if (findImageNode(writer, ast) != NULL)
+    {
+        return AST_WALK_CONTINUE;
+    }
+
+    size_t offset;
+
+    switch (ast->type)
+    {
+    case AST_TYPE_LITERAL_EXPRESSION_NODE:
+    {
+        AstLiteralExpression literal = *(AstLiteralExpression *)ast;
+        literal.info.dataType = TYPE_ID_INVALID;
+
+        if (literal.value.type == TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL)
+        {
+            literal.value.value.string = (char *)addImageString(writer, literal.value.value.string);
+        }
+
+        offset = writeImageBuffer(&writer->nodes, &literal, sizeof(literal));
+        break;
+    }
+
+    case AST_TYPE_UNARY_EXPRESSION_NODE:
+    {
+        AstUnaryExpression unary = *(AstUnaryExpression *)ast;
+        unary.info.dataType = TYPE_ID_INVALID;
+        unary.right = (Ast *)getImageNodeOffset(writer, unary.right);
+        offset = writeImageBuffer(&writer->nodes, &unary, sizeof(unary));
+        break;
+    }
+
+    case AST_TYPE_FUNCTION_DECLARATION_NODE:
+    {
+        AstFunctionDeclaration function = *(AstFunctionDeclaration *)ast;
+        function.info.dataType = TYPE_ID_INVALID;
+        function.name.lexeme = (char *)addImageString(writer, function.name.lexeme);
+
+        if (function.bodyCount > 0)
+        {
+            size_t bodyOffset = alignImageOffset(writer->nodes.count);
+
+            for (uint32_t i = 0; i < function.bodyCount; i++)
+            {
+                uintptr_t child = getImageNodeOffset(writer, function.body[i]);
+                writeImageBuffer(&writer->nodes, &child, sizeof(child));
+            }
+
+            function.body = (Ast **)(uintptr_t)(writer->nodesOffset + bodyOffset);
+        }
+        else
+        {
+            function.body = NULL;
+        }
+
+        offset = writeImageBuffer(&writer->nodes, &function, sizeof(function));
+        break;
+    }
+
+    case AST_TYPE_SWITCH_STATEMENT_NODE:
+    {
+        AstSwitchStatement statement = *(AstSwitchStatement *)ast;
+        statement.info.dataType = TYPE_ID_INVALID;
+        statement.selectorType = TYPE_ID_INVALID;
+        statement.selector = (Ast *)getImageNodeOffset(writer, statement.selector);
+        statement.defaultCase = (AstCaseLabel *)getImageNodeOffset(writer, (Ast *)statement.defaultCase);
+
+        if (statement.bodyCount > 0)
+        {
+            size_t bodyOffset = alignImageOffset(writer->nodes.count);
+
+            for (uint32_t i = 0; i < statement.bodyCount; i++)
+            {
+                uintptr_t child = getImageNodeOffset(writer, statement.body[i]);
+                writeImageBuffer(&writer->nodes, &child, sizeof(child));
+            }
+
+            statement.body = (Ast **)(uintptr_t)(writer->nodesOffset + bodyOffset);
+        }
+        else
+        {
+            statement.body = NULL;
+        }
+
+        if (statement.caseCount > 0)
+        {
+            size_t casesOffset = alignImageOffset(writer->nodes.count);
+
+            for (uint32_t i = 0; i < statement.caseCount; i++)
+            {
+                uintptr_t label = getImageNodeOffset(writer, (Ast *)statement.cases[i]);
+                writeImageBuffer(&writer->nodes, &label, sizeof(label));
+            }
+
+            statement.cases = (AstCaseLabel **)(uintptr_t)(writer->nodesOffset + casesOffset);
+        }
+        else
+        {
+            statement.cases = NULL;
+        }
+
+        offset = writeImageBuffer(&writer->nodes, &statement, sizeof(statement));
+        break;
+    }
+
+    case AST_TYPE_CASE_LABEL_NODE:
+    {
+        AstCaseLabel label = *(AstCaseLabel *)ast;
+        label.info.dataType = TYPE_ID_INVALID;
+        label.value = (Ast *)getImageNodeOffset(writer, label.value);
+        label.constant = 0;
+        label.key = 0;
+        offset = writeImageBuffer(&writer->nodes, &label, sizeof(label));
+        break;
+    }
+
+    case AST_TYPE_BREAK_STATEMENT_NODE:
+    {
+        AstBreakStatement statement = *(AstBreakStatement *)ast;
+        statement.info.dataType = TYPE_ID_INVALID;
+        offset = writeImageBuffer(&writer->nodes, &statement, sizeof(statement));
+        break;
+    }
+
+    default:
+        writer->failed = true;
+        return AST_WALK_STOP;
+    }
+
+    addImageNode(writer, ast, writer->nodesOffset + offset);
+    return AST_WALK_CONTINUE;
+}
+
+static bool writeImageFile(const char *path, const AstImageHeader *header, const ImageBuffer *sections, size_t count)
+{
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    static const char padding[AST_IMAGE_ALIGNMENT] = {0};
+    size_t position = sizeof(*header);
+    bool ok = fwrite(header, sizeof(*header), 1, file) == 1;
+
+    for (size_t i = 0; ok && i < count; i++)
+    {
+        size_t aligned = alignImageOffset(position);
+        ok = fwrite(padding, 1, aligned - position, file) == aligned - position &&
+             fwrite(sections[i].data, 1, sections[i].count, file) == sections[i].count;
+        position = aligned + sections[i].count;
+    }
+
+    return fclose(file) == 0 && ok;
+}
+
+void initAstImage(AstImage *image)
+{
+    image->base = NULL;
+    image->size = 0;
+    image->mapping = NULL;
+    image->tokens.count = 0;
+    image->tokens.capacity = 0;
+    image->tokens.tokens = NULL;
+    image->trees = NULL;
+    image->treeCount = 0;
+}
+
+bool saveAstImage(const char *path, TokenArray *tokens, AstArray *trees)
+{
+    AstImageHeader header = {0};
+    header.magic = AST_IMAGE_MAGIC;
+    header.version = AST_IMAGE_VERSION;
+    header.pointerSize = sizeof(void *);
+    header.tokenSize = sizeof(Token);
+    header.literalSize = sizeof(AstLiteralExpression);
+    header.unarySize = sizeof(AstUnaryExpression);
+    header.functionSize = sizeof(AstFunctionDeclaration);
+    header.switchSize = sizeof(AstSwitchStatement);
+    header.caseSize = sizeof(AstCaseLabel);
+    header.breakSize = sizeof(AstBreakStatement);
+    header.astSize = sizeof(Ast);
+    header.tokenCount = (uint32_t)tokens->count;
+    header.treeCount = (uint32_t)trees->count;
+    header.tokensOffset = alignImageOffset(sizeof(header));
+    header.treesOffset = alignImageOffset(header.tokensOffset + tokens->count * sizeof(Token));
+    header.nodesOffset = alignImageOffset(header.treesOffset + trees->count * sizeof(uintptr_t));
+
+    ImageWriter writer;
+    ImageBuffer sections[5];
+    initImageBuffer(&writer.nodes);
+    initImageBuffer(&writer.strings);
+    initImageBuffer(&writer.index);
+    initImageBuffer(&sections[0]);
+    initImageBuffer(&sections[1]);
+    initHashMap(&writer.entries, sizeof(ImageNodeEntry), MIN_ARRAY_SIZE, hashImageNode);
+    writer.nodesOffset = header.nodesOffset;
+    writer.failed = false;
+
+    for (size_t i = 0; i < tokens->count; i++)
+    {
+        Token token = tokens->tokens[i];
+        token.lexeme = (char *)addImageString(&writer, token.lexeme);
+
+        if (token.attribute.type == TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL)
+        {
+            token.attribute.value.string = (char *)addImageString(&writer, token.attribute.value.string);
+        }
+
+        writeImageBuffer(&sections[0], &token, sizeof(token));
+    }
+
+    AstWalker walker;
+    AstVisitor visitor = {enterImageNode, writeImageNode};
+    initAstWalker(&walker);
+
+    for (size_t i = 0; i < trees->count && !writer.failed; i++)
+    {
+        walkAst(&walker, trees->trees[i], &visitor, &writer);
+        uintptr_t root = getImageNodeOffset(&writer, trees->trees[i]);
+        writeImageBuffer(&sections[1], &root, sizeof(root));
+    }
+
+    freeAstWalker(&walker);
+
+    header.nodeCount = (uint32_t)writer.entries.count;
+    header.indexOffset = alignImageOffset(header.nodesOffset + writer.nodes.count);
+    header.stringsOffset = alignImageOffset(header.indexOffset + writer.index.count);
+    header.stringsSize = writer.strings.count;
+    header.size = header.stringsOffset + header.stringsSize;
+
+    sections[2] = writer.nodes;
+    sections[3] = writer.index;
+    sections[4] = writer.strings;
+
+    bool saved = !writer.failed && writeImageFile(path, &header, sections, 5);
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        freeImageBuffer(&sections[i]);
+    }
+
+    freeHashMap(&writer.entries);
+    return saved;
+}
+
+static bool mapImageFile(AstImage *image, const char *path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+
+    if (GetFileSizeEx(file, &size) && size.QuadPart >= (LONGLONG)sizeof(AstImageHeader))
+    {
+        mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    }
+
+    CloseHandle(file);
+
+    if (mapping == NULL)
+    {
+        return false;
+    }
+
+    image->base = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+
+    if (image->base == NULL)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    image->mapping = mapping;
+    image->size = (size_t)size.QuadPart;
+#else
+    int file = open(path, O_RDONLY);
+
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    void *base = MAP_FAILED;
+
+    if (fstat(file, &status) == 0 && (size_t)status.st_size >= sizeof(AstImageHeader))
+    {
+        base = mmap(NULL, (size_t)status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    }
+
+    close(file);
+
+    if (base == MAP_FAILED)
+    {
+        return false;
+    }
+
+    image->base = base;
+    image->size = (size_t)status.st_size;
+#endif
+
+    return true;
+}
+
+static bool isImageRange(const AstImage *image, uint64_t offset, uint64_t size)
+{
+    return offset % AST_IMAGE_ALIGNMENT == 0 && offset <= image->size && size <= image->size - offset;
+}
+
+static bool isImageBool(const bool *value)
+{
+    uint8_t byte;
+    memcpy(&byte, value, sizeof(byte));
+    return byte <= 1;
+}
+
+static bool relocateImageString(const AstImage *image, char **field)
+{
+    const AstImageHeader *header = (const AstImageHeader *)image->base;
+    uintptr_t reference = (uintptr_t)*field;
+
+    if (reference == 0)
+    {
+        *field = NULL;
+        return true;
+    }
+
+    if (reference - 1 >= header->stringsSize)
+    {
+        return false;
+    }
+
+    *field = image->base + header->stringsOffset + reference - 1;
+    return true;
+}
+
+static bool relocateImageNode(const AstImage *image, Ast **field, uint64_t limit)
+{
+    const AstImageHeader *header = (const AstImageHeader *)image->base;
+    const uint64_t *index = (const uint64_t *)(image->base + header->indexOffset);
+    uint64_t offset = (uintptr_t)*field;
+
+    if (offset == 0)
+    {
+        *field = NULL;
+        return true;
+    }
+
+    if (offset >= limit)
+    {
+        return false;
+    }
+
+    size_t low = 0;
+    size_t high = header->nodeCount;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (index[middle] < offset)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if (low >= header->nodeCount || index[low] != offset)
+    {
+        return false;
+    }
+
+    *field = (Ast *)(image->base + offset);
+    return true;
+}
+
+static bool relocateImageToken(const AstImage *image, Token *token)
+{
+    return relocateImageString(image, &token->lexeme) &&
+           (token->attribute.type != TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL ||
+            relocateImageString(image, &token->attribute.value.string));
+}
+
+static bool relocateImageNodes(const AstImage *image)
+{
+    const AstImageHeader *header = (const AstImageHeader *)image->base;
+    const uint64_t *index = (const uint64_t *)(image->base + header->indexOffset);
+
+    for (uint32_t i = 0; i < header->nodeCount; i++)
+    {
+        uint64_t offset = index[i];
+
+        if (offset < header->nodesOffset || (i > 0 && offset <= index[i - 1]) ||
+            !isImageRange(image, offset, sizeof(Ast)) || offset + sizeof(Ast) > header->indexOffset)
+        {
+            return false;
+        }
+
+        Ast *ast = (Ast *)(image->base + offset);
+        uint64_t size;
+
+        switch (ast->type)
+        {
+        case AST_TYPE_LITERAL_EXPRESSION_NODE:
+            size = sizeof(AstLiteralExpression);
+            break;
+
+        case AST_TYPE_UNARY_EXPRESSION_NODE:
+            size = sizeof(AstUnaryExpression);
+            break;
+
+        case AST_TYPE_FUNCTION_DECLARATION_NODE:
+            size = sizeof(AstFunctionDeclaration);
+            break;
+
+        case AST_TYPE_SWITCH_STATEMENT_NODE:
+            size = sizeof(AstSwitchStatement);
+            break;
+
+        case AST_TYPE_CASE_LABEL_NODE:
+            size = sizeof(AstCaseLabel);
+            break;
+
+        case AST_TYPE_BREAK_STATEMENT_NODE:
+            size = sizeof(AstBreakStatement);
+            break;
+
+        default:
+            return false;
+        }
+
+        if (offset + size > header->indexOffset)
+        {
+            return false;
+        }
+
+        switch (ast->type)
+        {
+        case AST_TYPE_LITERAL_EXPRESSION_NODE:
+        {
+            AstLiteralExpression *literal = (AstLiteralExpression *)ast;
+
+            if (literal->value.type == TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL &&
+                !relocateImageString(image, &literal->value.value.string))
+            {
+                return false;
+            }
+
+            break;
+        }
+
+        case AST_TYPE_UNARY_EXPRESSION_NODE:
+            if (!relocateImageNode(image, &((AstUnaryExpression *)ast)->right, offset))
+            {
+                return false;
+            }
+
+            break;
+
+        case AST_TYPE_FUNCTION_DECLARATION_NODE:
+        {
+            AstFunctionDeclaration *function = (AstFunctionDeclaration *)ast;
+            uint64_t bodyOffset = (uintptr_t)function->body;
+            uint64_t bodySize = (uint64_t)function->bodyCount * sizeof(Ast *);
+
+            if (!isImageBool(&function->internal) || !isImageBool(&function->referenced) ||
+                !isImageBool(&function->parsed) || function->nameIndex >= function->bodyStart ||
+                function->bodyStart >= function->bodyEnd || function->bodyEnd >= header->tokenCount ||
+                !relocateImageToken(image, &function->name) ||
+                (function->bodyCount > 0 && (bodyOffset < header->nodesOffset || bodyOffset > offset ||
+                                             !isImageRange(image, bodyOffset, bodySize) || bodyOffset + bodySize > offset)))
+            {
+                return false;
+            }
+
+            function->body = function->bodyCount > 0 ? (Ast **)(image->base + bodyOffset) : NULL;
+
+            for (uint32_t j = 0; j < function->bodyCount; j++)
+            {
+                if (!relocateImageNode(image, &function->body[j], offset) || function->body[j] == NULL)
+                {
+                    return false;
+                }
+            }
+
+            break;
+        }
+
+        case AST_TYPE_SWITCH_STATEMENT_NODE:
+        {
+            AstSwitchStatement *statement = (AstSwitchStatement *)ast;
+            uint64_t bodyOffset = (uintptr_t)statement->body;
+            uint64_t bodySize = (uint64_t)statement->bodyCount * sizeof(Ast *);
+            uint64_t casesOffset = (uintptr_t)statement->cases;
+            uint64_t casesSize = (uint64_t)statement->caseCount * sizeof(AstCaseLabel *);
+
+            if (!relocateImageNode(image, &statement->selector, offset) || statement->selector == NULL ||
+                !relocateImageNode(image, (Ast **)&statement->defaultCase, offset) ||
+                (statement->defaultCase != NULL && (statement->defaultCase->info.type != AST_TYPE_CASE_LABEL_NODE ||
+                                                    statement->defaultCase->value != NULL)) ||
+                (statement->bodyCount > 0 && (bodyOffset < header->nodesOffset || bodyOffset > offset ||
+                                              !isImageRange(image, bodyOffset, bodySize) || bodyOffset + bodySize > offset)) ||
+                (statement->caseCount > 0 && (casesOffset < header->nodesOffset || casesOffset > offset ||
+                                              !isImageRange(image, casesOffset, casesSize) || casesOffset + casesSize > offset)))
+            {
+                return false;
+            }
+
+            statement->body = statement->bodyCount > 0 ? (Ast **)(image->base + bodyOffset) : NULL;
+            statement->cases = statement->caseCount > 0 ? (AstCaseLabel **)(image->base + casesOffset) : NULL;
+
+            for (uint32_t j = 0; j < statement->bodyCount; j++)
+            {
+                if (!relocateImageNode(image, &statement->body[j], offset) || statement->body[j] == NULL)
+                {
+                    return false;
+                }
+            }
+
+            for (uint32_t j = 0; j < statement->caseCount; j++)
+            {
+                if (!relocateImageNode(image, (Ast **)&statement->cases[j], offset) || statement->cases[j] == NULL ||
+                    statement->cases[j]->info.type != AST_TYPE_CASE_LABEL_NODE || statement->cases[j]->value == NULL)
+                {
+                    return false;
+                }
+            }
+
+            break;
+        }
+
+        case AST_TYPE_CASE_LABEL_NODE:
+            if (!relocateImageNode(image, &((AstCaseLabel *)ast)->value, offset))
+            {
+                return false;
+            }
+
+            break;
+
+        case AST_TYPE_BREAK_STATEMENT_NODE:
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool relocateAstImage(AstImage *image)
+{
+    const AstImageHeader *header = (const AstImageHeader *)image->base;
+
+    if (header->magic != AST_IMAGE_MAGIC || header->version != AST_IMAGE_VERSION ||
+        header->pointerSize != sizeof(void *) || header->tokenSize != sizeof(Token) ||
+        header->literalSize != sizeof(AstLiteralExpression) || header->unarySize != sizeof(AstUnaryExpression) ||
+        header->functionSize != sizeof(AstFunctionDeclaration) || header->switchSize != sizeof(AstSwitchStatement) ||
+        header->caseSize != sizeof(AstCaseLabel) || header->breakSize != sizeof(AstBreakStatement) ||
+        header->astSize != sizeof(Ast) || header->size != image->size ||
+        !isImageRange(image, header->tokensOffset, (uint64_t)header->tokenCount * sizeof(Token)) ||
+        !isImageRange(image, header->treesOffset, (uint64_t)header->treeCount * sizeof(Ast *)) ||
+        !isImageRange(image, header->indexOffset, (uint64_t)header->nodeCount * sizeof(uint64_t)) ||
+        header->nodesOffset > header->indexOffset || header->stringsOffset + header->stringsSize != image->size ||
+        (header->stringsSize > 0 && image->base[image->size - 1] != '\0'))
+    {
+        return false;
+    }
+
+    if (!relocateImageNodes(image))
+    {
+        return false;
+    }
+
+    Token *tokens = (Token *)(image->base + header->tokensOffset);
+
+    if (header->tokenCount == 0 || tokens[header->tokenCount - 1].type != TOKEN_TYPE_EOF)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header->tokenCount; i++)
+    {
+        if (!relocateImageToken(image, &tokens[i]))
+        {
+            return false;
+        }
+    }
+
+    Ast **trees = (Ast **)(image->base + header->treesOffset);
+
+    for (uint32_t i = 0; i < header->treeCount; i++)
+    {
+        if (!relocateImageNode(image, &trees[i], header->indexOffset) || trees[i] == NULL)
+        {
+            return false;
+        }
+    }
+
+    image->tokens.count = header->tokenCount;
+    image->tokens.capacity = header->tokenCount;
+    image->tokens.tokens = tokens;
+    image->trees = trees;
+    image->treeCount = header->treeCount;
+
+    return true;
+}
+
+bool loadAstImage(AstImage *image, const char *path)
+{
+    unloadAstImage(image);
+
+    if (!mapImageFile(image, path))
+    {
+        initAstImage(image);
+        return false;
+    }
+
+    if (!relocateAstImage(image))
+    {
+        unloadAstImage(image);
+        return false;
+    }
+
+    return true;
+}
+
+void unloadAstImage(AstImage *image)
+{
+    if (image->base != NULL)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(image->base);
+        CloseHandle((HANDLE)image->mapping);
+#else
+        munmap(image->base, image->size);
+#endif
+    }
+
+    initAstImage(image);
+}
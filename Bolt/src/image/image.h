@@ -0,0 +1,51 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <parsing.h>
+
+#define AST_IMAGE_MAGIC 0x48435042
+#define AST_IMAGE_VERSION 3
+#define AST_IMAGE_ALIGNMENT 8
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t pointerSize;
+    uint16_t tokenSize;
+    uint16_t literalSize;
+    uint16_t unarySize;
+    uint16_t functionSize;
+    uint16_t switchSize;
+    uint16_t caseSize;
+    uint16_t breakSize;
+    uint16_t astSize;
+    uint32_t tokenCount;
+    uint32_t treeCount;
+    uint32_t nodeCount;
+    uint32_t reserved;
+    uint64_t tokensOffset;
+    uint64_t treesOffset;
+    uint64_t nodesOffset;
+    uint64_t indexOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t size;
+} AstImageHeader;
+
+typedef struct
+{
+    char *base;
+    size_t size;
+    void *mapping;
+    TokenArray tokens;
+    Ast **trees;
+    size_t treeCount;
+} AstImage;
+
+void initAstImage(AstImage *image);
+bool saveAstImage(const char *path, TokenArray *tokens, AstArray *trees);
+bool loadAstImage(AstImage *image, const char *path);
+void unloadAstImage(AstImage *image);
+
+#endif
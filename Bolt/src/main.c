@@ -1,15 +1,144 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <compiler.h>
+#include <server.h>
+#include <protocol.h>
+#include <parallel.h>
+#include <watch.h>
 
-int main(void)
+int main(int argc, char **argv)
 {
+    const char *inputPath = NULL;
+    const char *outputPath = "C:/Github/CDev/BoltC/test.s";
+    const char *socketPath = NULL;
+    const char *imagePath = NULL;
+    const char *imageOutputPath = NULL;
+    const char *profileGeneratePath = NULL;
+    const char *profileUsePath = NULL;
+    uint32_t workerCount = (uint32_t)getProcessorCount();
+    bool hashCons = false;
+    bool lazyBodies = false;
+    bool watch = false;
+    bool passStatistics = false;
+    OptimizationLevel level = OPTIMIZATION_LEVEL_0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--server") == 0)
+        {
+            socketPath = i + 1 < argc && argv[i + 1][0] != '-' ? argv[++i] : COMPILE_SERVER_DEFAULT_SOCKET;
+        }
+        else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc)
+        {
+            workerCount = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--hash-cons") == 0)
+        {
+            hashCons = true;
+        }
+        else if (strcmp(argv[i], "--watch") == 0)
+        {
+            watch = true;
+        }
+        else if (strcmp(argv[i], "--lazy-bodies") == 0)
+        {
+            lazyBodies = true;
+        }
+        else if (strncmp(argv[i], "-O", 2) == 0 && argv[i][2] >= '0' && argv[i][2] <= '9' && argv[i][3] == '\0')
+        {
+            level = argv[i][2] >= '2' ? OPTIMIZATION_LEVEL_2 : (OptimizationLevel)(argv[i][2] - '0');
+        }
+        else if (strcmp(argv[i], "--pass-stats") == 0)
+        {
+            passStatistics = true;
+        }
+        else if (strcmp(argv[i], "--image") == 0 && i + 1 < argc)
+        {
+            imagePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--emit-image") == 0 && i + 1 < argc)
+        {
+            imageOutputPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--profile-generate") == 0 && i + 1 < argc)
+        {
+            /* The instrumented program opens this path with "wb" at exit, so every run overwrites the previous
+               profile instead of accumulating counts. */
+            profileGeneratePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--profile-use") == 0 && i + 1 < argc)
+        {
+            profileUsePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            outputPath = argv[++i];
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            fprintf(stderr, "Error: Unsupported option '%s'.\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+        else if (inputPath != NULL)
+        {
+            fprintf(stderr, "Error: Multiple inputs '%s' and '%s'.\n", inputPath, argv[i]);
+            return EXIT_FAILURE;
+        }
+        else
+        {
+            inputPath = argv[i];
+        }
+    }
+
+    if (inputPath == NULL)
+    {
+        inputPath = "C:/Github/CDev/BoltC/test.txt";
+    }
+
+    if (socketPath != NULL)
+    {
+        return runCompileServer(socketPath, workerCount) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     Compiler compiler;
     initCompiler(&compiler);
-    setCompilerRoot(&compiler, "C:/Github/CDev/BoltC/test.txt");
-    compileCode(&compiler);
+    setCompilerOutput(&compiler, outputPath);
+    setCompilerHashCons(&compiler, hashCons);
+    setCompilerLazyBodies(&compiler, lazyBodies);
+    setCompilerOptimizationLevel(&compiler, level);
+    setCompilerPassStatistics(&compiler, passStatistics);
+    setCompilerImageOutput(&compiler, imageOutputPath);
+
+    if (profileGeneratePath != NULL)
+    {
+        setCompilerProfileGenerate(&compiler, profileGeneratePath);
+    }
+
+    if (profileUsePath != NULL && !setCompilerProfileUse(&compiler, profileUsePath))
+    {
+        fprintf(stderr, "%s\n", compiler.error);
+        freeCompiler(&compiler);
+        return EXIT_FAILURE;
+    }
+
+    if (watch)
+    {
+        compiler.parser.printTrees = false;
+        bool watched = runWatchMode(&compiler, inputPath, outputPath);
+        freeCompiler(&compiler);
+        return watched ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    bool loaded = imagePath != NULL ? setCompilerImage(&compiler, imagePath) : setCompilerRoot(&compiler, inputPath);
+
+    if (!loaded || compileCode(&compiler) != COMPILER_STATUS_OK)
+    {
+        fprintf(stderr, "%s\n", compiler.error);
+        return EXIT_FAILURE;
+    }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -1,14 +1,54 @@
 #include <memory.h>
 #include <stdlib.h>
 
+static THREAD_LOCAL const Allocator *currentAllocator = NULL;
+
+const Allocator *getAllocator(void)
+{
+    return currentAllocator;
+}
+
+const Allocator *setAllocator(const Allocator *allocator)
+{
+    const Allocator *previous = currentAllocator;
+    currentAllocator = allocator;
+    return previous;
+}
+
 void *allocate(size_t count)
 {
+    if (currentAllocator != NULL)
+    {
+        return currentAllocator->allocate(currentAllocator->userData, count);
+    }
+
     void *ptr = malloc(count);
     return ptr;
 }
 
 void *reallocate(void *ptr, size_t old_size, size_t new_size)
 {
+    if (currentAllocator != NULL)
+    {
+        return currentAllocator->reallocate(currentAllocator->userData, ptr, old_size, new_size);
+    }
+
     void *new_ptr = realloc(ptr, new_size);
     return new_ptr;
 }
+
+void deallocate(void *ptr)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    if (currentAllocator != NULL)
+    {
+        currentAllocator->deallocate(currentAllocator->userData, ptr);
+        return;
+    }
+
+    free(ptr);
+}
@@ -0,0 +1,32 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT 16
+
+typedef struct ArenaBlock
+{
+    struct ArenaBlock *next;
+    size_t size;
+    size_t used;
+} ArenaBlock;
+
+typedef struct
+{
+    ArenaBlock *blocks;
+    ArenaBlock *spare;
+    size_t blockSize;
+} Arena;
+
+void initArena(Arena *arena, size_t blockSize);
+void *arenaAllocate(Arena *arena, size_t size);
+void mergeArena(Arena *arena, Arena *other);
+void resetArena(Arena *arena);
+void freeArena(Arena *arena);
+
+#define ARENA_ALLOCATE(arena, type, count) (type *)arenaAllocate(arena, (count) * sizeof(type))
+
+#endif
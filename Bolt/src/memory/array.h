@@ -1,12 +1,91 @@
 #ifndef ARRAY_H
 #define ARRAY_H
 
+#include <memory.h>
+#include <arena.h>
+#include <string.h>
+
 #define MIN_ARRAY_SIZE 16
 
-typedef struct
-{
-    size_t count;
-    size_t capacity;
-} Array;
+#define DECLARE_ARRAY(Name, Type, items)                                                                               \
+    typedef struct Name                                                                                                \
+    {                                                                                                                  \
+        size_t count;                                                                                                  \
+        size_t capacity;                                                                                               \
+        Type *items;                                                                                                   \
+    } Name;                                                                                                            \
+                                                                                                                       \
+    void init##Name(Name *array);                                                                                      \
+    void reserve##Name(Name *array, size_t capacity);                                                                  \
+    void append##Name(Name *array, Type item);                                                                         \
+    void shrink##Name(Name *array);                                                                                    \
+    void free##Name(Name *array);                                                                                      \
+    Type *copy##Name##ToArena(const Name *array, Arena *arena)
+
+#define DEFINE_ARRAY(Name, Type, items)                                                                                \
+    void init##Name(Name *array)                                                                                       \
+    {                                                                                                                  \
+        array->count = 0;                                                                                              \
+        array->capacity = MIN_ARRAY_SIZE;                                                                              \
+        array->items = ALLOCATE(Type, MIN_ARRAY_SIZE);                                                                 \
+    }                                                                                                                  \
+                                                                                                                       \
+    void reserve##Name(Name *array, size_t capacity)                                                                   \
+    {                                                                                                                  \
+        if (capacity <= array->capacity)                                                                               \
+        {                                                                                                              \
+            return;                                                                                                    \
+        }                                                                                                              \
+                                                                                                                       \
+        array->items = REALLOCATE(Type, array->items, array->capacity, capacity);                                      \
+        array->capacity = capacity;                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    void append##Name(Name *array, Type item)                                                                          \
+    {                                                                                                                  \
+        if (array->count >= array->capacity)                                                                           \
+        {                                                                                                              \
+            reserve##Name(array, array->capacity > 0 ? array->capacity * ARRAY_GROW_FACTOR : MIN_ARRAY_SIZE);          \
+        }                                                                                                              \
+                                                                                                                       \
+        array->items[array->count++] = item;                                                                           \
+    }                                                                                                                  \
+                                                                                                                       \
+    void shrink##Name(Name *array)                                                                                     \
+    {                                                                                                                  \
+        if (array->count == array->capacity)                                                                           \
+        {                                                                                                              \
+            return;                                                                                                    \
+        }                                                                                                              \
+                                                                                                                       \
+        if (array->count == 0)                                                                                         \
+        {                                                                                                              \
+            free##Name(array);                                                                                         \
+            return;                                                                                                    \
+        }                                                                                                              \
+                                                                                                                       \
+        array->items = REALLOCATE(Type, array->items, array->capacity, array->count);                                  \
+        array->capacity = array->count;                                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    void free##Name(Name *array)                                                                                       \
+    {                                                                                                                  \
+        FREE(array->items);                                                                                            \
+        array->items = NULL;                                                                                           \
+        array->count = 0;                                                                                              \
+        array->capacity = 0;                                                                                           \
+    }                                                                                                                  \
+                                                                                                                       \
+    Type *copy##Name##ToArena(const Name *array, Arena *arena)                                                         \
+    {                                                                                                                  \
+        if (array->count == 0)                                                                                         \
+        {                                                                                                              \
+            return NULL;                                                                                               \
+        }                                                                                                              \
+                                                                                                                       \
+        Type *items = ARENA_ALLOCATE(arena, Type, array->count);                                                       \
+        memcpy(items, array->items, array->count * sizeof(Type));                                                      \
+        return items;                                                                                                  \
+    }
 
-#endif
\ No newline at end of file
+#endif
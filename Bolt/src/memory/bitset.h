@@ -0,0 +1,31 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BITSET_WORD_BITS 64
+#define BITSET_WORDS(bits) (((bits) + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS)
+
+typedef struct
+{
+    size_t bitCount;
+    size_t wordCount;
+    uint64_t *words;
+} BitSet;
+
+void initBitSet(BitSet *set, size_t bitCount);
+void viewBitSet(BitSet *set, uint64_t *words, size_t bitCount);
+void freeBitSet(BitSet *set);
+void setBit(BitSet *set, size_t bit);
+void clearBit(BitSet *set, size_t bit);
+bool testBit(const BitSet *set, size_t bit);
+void clearBitSet(BitSet *set);
+void fillBitSet(BitSet *set);
+void copyBitSet(BitSet *target, const BitSet *source);
+bool unionBitSet(BitSet *target, const BitSet *source);
+bool intersectBitSet(BitSet *target, const BitSet *source);
+size_t findNextBit(const BitSet *set, size_t from);
+
+#endif
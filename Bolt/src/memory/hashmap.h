@@ -0,0 +1,43 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define HASH_MAP_GROUP_SIZE 16
+#define HASH_MAP_MIN_CAPACITY 16
+#define HASH_MAP_MAX_LOAD_NUMERATOR 7
+#define HASH_MAP_MAX_LOAD_DENOMINATOR 8
+#define HASH_MAP_CONTROL_EMPTY 0x80
+
+typedef uint64_t (*HashMapHashFunction)(const void *slot);
+
+typedef struct
+{
+    size_t count;
+    size_t capacity;
+    size_t slotSize;
+    uint8_t *control;
+    char *slots;
+    HashMapHashFunction hash;
+} HashMap;
+
+typedef struct
+{
+    size_t position;
+    size_t stride;
+    uint32_t matches;
+    bool last;
+    uint8_t tag;
+} HashMapProbe;
+
+void initHashMap(HashMap *map, size_t slotSize, size_t capacity, HashMapHashFunction hash);
+void resetHashMap(HashMap *map);
+void freeHashMap(HashMap *map);
+void reserveHashMap(HashMap *map, size_t count);
+void startHashMapProbe(const HashMap *map, uint64_t hash, HashMapProbe *probe);
+void *nextHashMapMatch(const HashMap *map, HashMapProbe *probe);
+void *insertHashMap(HashMap *map, uint64_t hash);
+
+#endif
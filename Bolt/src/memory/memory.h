@@ -1,15 +1,35 @@
 #ifndef MEMORY_H
 #define MEMORY_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+typedef struct
+{
+    void *(*allocate)(void *userData, size_t size);
+    void *(*reallocate)(void *userData, void *ptr, size_t oldSize, size_t newSize);
+    void (*deallocate)(void *userData, void *ptr);
+    void *userData;
+} Allocator;
+
+const Allocator *getAllocator(void);
+const Allocator *setAllocator(const Allocator *allocator);
+
 void *allocate(size_t count);
 void *reallocate(void *ptr, size_t old_size, size_t new_size);
+void deallocate(void *ptr);
 
 #define REALLOCATE(type, ptr, old_count, new_count) \
-    (type *)reallocate(ptr, old_count * sizeof(type), new_count * sizeof(type))
+    (type *)reallocate(ptr, (old_count) * sizeof(type), (new_count) * sizeof(type))
 
-#define ALLOCATE(type, count) (type *)allocate(count * sizeof(type))
+#define ALLOCATE(type, count) (type *)allocate((count) * sizeof(type))
+#define FREE(ptr) deallocate(ptr)
 #define ARRAY_GROW_FACTOR 2
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,234 @@
+#include <optimizer.h>
+#include <folding.h>
+#include <elimination.h>
+#include <memory.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct
+{
+    const PassId *passes;
+    size_t count;
+} PassPipeline;
+
+typedef struct
+{
+    const Allocator *previous;
+    atomic_size_t allocated;
+} PassMeter;
+
+static bool runTypeAnalysisPass(PassContext *context, size_t *changed)
+{
+    *changed = 0;
+    return analyzeTrees(context->analyzer, &context->parser->trees);
+}
+
+static bool runFoldPass(PassContext *context, size_t *changed)
+{
+    *changed = foldConstants(context->parser, &context->analyzer->types);
+    return true;
+}
+
+static bool runDeadCodePass(PassContext *context, size_t *changed)
+{
+    *changed = eliminateUnreachableCode(context->parser);
+    return true;
+}
+
+static const Pass passes[PASS_ID_COUNT] = {
+    {"types", PASS_ANALYSIS_NONE, PASS_ANALYSIS_TYPES, PASS_ANALYSIS_NONE, runTypeAnalysisPass},
+    {"fold", PASS_ANALYSIS_TYPES, PASS_ANALYSIS_NONE, PASS_ANALYSIS_NONE, runFoldPass},
+    {"dce", PASS_ANALYSIS_TYPES, PASS_ANALYSIS_NONE, PASS_ANALYSIS_NONE, runDeadCodePass},
+};
+
+static const PassId level0Passes[] = {PASS_ID_TYPES};
+static const PassId level1Passes[] = {PASS_ID_TYPES, PASS_ID_FOLD, PASS_ID_DCE};
+
+static const PassPipeline pipelines[] = {
+    {level0Passes, sizeof(level0Passes) / sizeof(level0Passes[0])},
+    {level1Passes, sizeof(level1Passes) / sizeof(level1Passes[0])},
+    /* -O2 has no passes of its own yet and is an alias of the -O1 pipeline. */
+    {level1Passes, sizeof(level1Passes) / sizeof(level1Passes[0])},
+};
+
+static void *meterAllocate(void *userData, size_t size)
+{
+    PassMeter *meter = userData;
+    atomic_fetch_add(&meter->allocated, size);
+
+    if (meter->previous != NULL)
+    {
+        return meter->previous->allocate(meter->previous->userData, size);
+    }
+
+    return malloc(size);
+}
+
+static void *meterReallocate(void *userData, void *ptr, size_t oldSize, size_t newSize)
+{
+    PassMeter *meter = userData;
+
+    if (newSize > oldSize)
+    {
+        atomic_fetch_add(&meter->allocated, newSize - oldSize);
+    }
+
+    if (meter->previous != NULL)
+    {
+        return meter->previous->reallocate(meter->previous->userData, ptr, oldSize, newSize);
+    }
+
+    return realloc(ptr, newSize);
+}
+
+static void meterDeallocate(void *userData, void *ptr)
+{
+    PassMeter *meter = userData;
+
+    if (meter->previous != NULL)
+    {
+        meter->previous->deallocate(meter->previous->userData, ptr);
+        return;
+    }
+
+    free(ptr);
+}
+
+static double getPassMilliseconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1000000.0;
+}
+
+static bool ensureAnalyses(PassManager *manager, PassContext *context, uint32_t required)
+{
+    for (uint32_t id = 0; id < PASS_ID_COUNT; id++)
+    {
+        uint32_t missing = required & ~manager->validAnalyses;
+
+        if (missing == PASS_ANALYSIS_NONE)
+        {
+            return true;
+        }
+
+        if ((passes[id].provides & missing) != 0 && !runPass(manager, context, (PassId)id))
+        {
+            return false;
+        }
+    }
+
+    return (required & ~manager->validAnalyses) == PASS_ANALYSIS_NONE;
+}
+
+void initPassManager(PassManager *manager)
+{
+    manager->level = OPTIMIZATION_LEVEL_0;
+    manager->collectStatistics = false;
+    resetPassManager(manager);
+}
+
+void resetPassManager(PassManager *manager)
+{
+    manager->validAnalyses = PASS_ANALYSIS_NONE;
+
+    for (size_t i = 0; i < PASS_ID_COUNT; i++)
+    {
+        manager->statistics[i].runs = 0;
+        manager->statistics[i].changed = 0;
+        manager->statistics[i].allocated = 0;
+        manager->statistics[i].milliseconds = 0.0;
+    }
+}
+
+void setPassManagerLevel(PassManager *manager, OptimizationLevel level)
+{
+    manager->level = level;
+}
+
+bool runPassManager(PassManager *manager, PassContext *context, uint32_t required)
+{
+    const PassPipeline *pipeline = &pipelines[manager->level];
+
+    for (size_t i = 0; i < pipeline->count; i++)
+    {
+        const Pass *pass = &passes[pipeline->passes[i]];
+
+        if (pass->provides != PASS_ANALYSIS_NONE && (pass->provides & ~manager->validAnalyses) == PASS_ANALYSIS_NONE)
+        {
+            continue;
+        }
+
+        if (!runPass(manager, context, pipeline->passes[i]))
+        {
+            return false;
+        }
+    }
+
+    return ensureAnalyses(manager, context, required);
+}
+
+bool runPass(PassManager *manager, PassContext *context, PassId id)
+{
+    const Pass *pass = &passes[id];
+
+    if (!ensureAnalyses(manager, context, pass->required))
+    {
+        return false;
+    }
+
+    PassStatistics *statistics = &manager->statistics[id];
+    size_t changed = 0;
+    bool succeeded;
+
+    if (manager->collectStatistics)
+    {
+        PassMeter meter;
+        meter.previous = getAllocator();
+        atomic_init(&meter.allocated, 0);
+
+        Allocator allocator = {meterAllocate, meterReallocate, meterDeallocate, &meter};
+        const Allocator *previous = setAllocator(&allocator);
+        double start = getPassMilliseconds();
+
+        succeeded = pass->run(context, &changed);
+
+        statistics->milliseconds += getPassMilliseconds() - start;
+        setAllocator(previous);
+        statistics->allocated += atomic_load(&meter.allocated);
+    }
+    else
+    {
+        succeeded = pass->run(context, &changed);
+    }
+
+    statistics->runs++;
+    statistics->changed += changed;
+
+    if (!succeeded)
+    {
+        return false;
+    }
+
+    manager->validAnalyses = (manager->validAnalyses & ~pass->invalidates) | pass->provides;
+    return true;
+}
+
+void printPassStatistics(PassManager *manager, FILE *stream)
+{
+    fprintf(stream, "%-8s %6s %10s %12s %12s\n", "Pass", "Runs", "Changed", "Allocated", "Time (ms)");
+
+    for (size_t i = 0; i < PASS_ID_COUNT; i++)
+    {
+        PassStatistics *statistics = &manager->statistics[i];
+
+        if (statistics->runs == 0)
+        {
+            continue;
+        }
+
+        fprintf(stream, "%-8s %6u %10zu %12zu %12.3f\n", passes[i].name, statistics->runs, statistics->changed,
+                statistics->allocated, statistics->milliseconds);
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef DATAFLOW_H
+#define DATAFLOW_H
+
+#include <parsing.h>
+#include <bitset.h>
+
+#define FLOW_BLOCK_NONE UINT32_MAX
+
+typedef struct
+{
+    Ast *owner;
+    Ast **body;
+    uint32_t count;
+} FlowRegion;
+
+typedef struct
+{
+    uint32_t region;
+    uint32_t start;
+    uint32_t count;
+    uint32_t firstSuccessor;
+    uint32_t successorCount;
+    uint32_t firstPredecessor;
+    uint32_t predecessorCount;
+} FlowBlock;
+
+typedef struct
+{
+    uint32_t from;
+    uint32_t to;
+} FlowEdge;
+
+typedef struct
+{
+    uint32_t region;
+    uint32_t index;
+    uint32_t current;
+    uint32_t dispatch;
+    uint32_t exit;
+} FlowFrame;
+
+typedef struct
+{
+    uint32_t blockCount;
+    uint32_t blockCapacity;
+    FlowBlock *blocks;
+    uint32_t *order;
+    uint32_t *position;
+    uint32_t *cursor;
+    uint32_t orderCount;
+    uint32_t edgeCount;
+    uint32_t edgeCapacity;
+    FlowEdge *edges;
+    uint32_t *successors;
+    uint32_t *predecessors;
+    uint32_t regionCount;
+    uint32_t regionCapacity;
+    FlowRegion *regions;
+    uint32_t frameCount;
+    uint32_t frameCapacity;
+    FlowFrame *frames;
+} FlowGraph;
+
+typedef enum
+{
+    DATAFLOW_DIRECTION_FORWARD,
+    DATAFLOW_DIRECTION_BACKWARD,
+} DataflowDirection;
+
+typedef enum
+{
+    DATAFLOW_MEET_UNION,
+    DATAFLOW_MEET_INTERSECTION,
+} DataflowMeet;
+
+typedef struct
+{
+    DataflowDirection direction;
+    DataflowMeet meet;
+    uint32_t blockCount;
+    BitSet boundary;
+    BitSet *gen;
+    BitSet *kill;
+    BitSet *in;
+    BitSet *out;
+    uint64_t *words;
+} DataflowProblem;
+
+void initFlowGraph(FlowGraph *graph);
+void buildFlowGraph(FlowGraph *graph, AstFunctionDeclaration *function);
+void freeFlowGraph(FlowGraph *graph);
+void initDataflowProblem(DataflowProblem *problem, const FlowGraph *graph, DataflowDirection direction,
+                         DataflowMeet meet, size_t bitCount);
+void solveDataflowProblem(DataflowProblem *problem, const FlowGraph *graph);
+void freeDataflowProblem(DataflowProblem *problem);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef ELIMINATION_H
+#define ELIMINATION_H
+
+#include <parsing.h>
+
+size_t eliminateUnreachableCode(Parser *parser);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef FOLDING_H
+#define FOLDING_H
+
+#include <parsing.h>
+#include <types.h>
+
+size_t foldConstants(Parser *parser, const TypeTable *types);
+Ast *foldUnaryExpression(Parser *parser, const TypeTable *types, AstUnaryExpression *ast);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <parsing.h>
+#include <semantic.h>
+#include <stdio.h>
+
+typedef enum
+{
+    OPTIMIZATION_LEVEL_0,
+    OPTIMIZATION_LEVEL_1,
+    OPTIMIZATION_LEVEL_2,
+} OptimizationLevel;
+
+typedef enum
+{
+    PASS_ANALYSIS_NONE = 0,
+    PASS_ANALYSIS_TYPES = 1 << 0,
+} PassAnalysis;
+
+typedef enum
+{
+    PASS_ID_TYPES,
+    PASS_ID_FOLD,
+    PASS_ID_DCE,
+    PASS_ID_COUNT,
+} PassId;
+
+typedef struct
+{
+    Parser *parser;
+    Analyzer *analyzer;
+} PassContext;
+
+typedef bool (*PassFunction)(PassContext *context, size_t *changed);
+
+typedef struct
+{
+    const char *name;
+    uint32_t required;
+    uint32_t provides;
+    uint32_t invalidates;
+    PassFunction run;
+} Pass;
+
+typedef struct
+{
+    uint32_t runs;
+    size_t changed;
+    size_t allocated;
+    double milliseconds;
+} PassStatistics;
+
+typedef struct
+{
+    OptimizationLevel level;
+    uint32_t validAnalyses;
+    bool collectStatistics;
+    PassStatistics statistics[PASS_ID_COUNT];
+} PassManager;
+
+void initPassManager(PassManager *manager);
+void resetPassManager(PassManager *manager);
+void setPassManagerLevel(PassManager *manager, OptimizationLevel level);
+bool runPassManager(PassManager *manager, PassContext *context, uint32_t required);
+bool runPass(PassManager *manager, PassContext *context, PassId id);
+void printPassStatistics(PassManager *manager, FILE *stream);
+
+#endif
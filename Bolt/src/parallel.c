@@ -0,0 +1,103 @@
+#include <parallel.h>
+#include <memory.h>
+#include <threads.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+typedef struct
+{
+    ParallelTask task;
+    const Allocator *allocator;
+    void *context;
+    size_t count;
+    size_t next;
+    mtx_t lock;
+} ParallelJob;
+
+static int runParallelWorker(void *argument)
+{
+    ParallelJob *job = (ParallelJob *)argument;
+    const Allocator *previous = setAllocator(job->allocator);
+
+    for (;;)
+    {
+        mtx_lock(&job->lock);
+        size_t index = job->next++;
+        mtx_unlock(&job->lock);
+
+        if (index >= job->count)
+        {
+            break;
+        }
+
+        job->task(job->context, index);
+    }
+
+    setAllocator(previous);
+    return 0;
+}
+
+size_t getProcessorCount(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+#endif
+}
+
+void runParallel(ParallelTask task, void *context, size_t count, size_t threadCount)
+{
+    if (threadCount > count)
+    {
+        threadCount = count;
+    }
+
+    if (threadCount <= 1)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            task(context, i);
+        }
+
+        return;
+    }
+
+    ParallelJob job;
+    job.task = task;
+    job.allocator = getAllocator();
+    job.context = context;
+    job.count = count;
+    job.next = 0;
+    mtx_init(&job.lock, mtx_plain);
+
+    thrd_t *threads = ALLOCATE(thrd_t, threadCount - 1);
+    size_t started = 0;
+
+    for (size_t i = 0; i < threadCount - 1; i++)
+    {
+        if (thrd_create(&threads[started], runParallelWorker, &job) != thrd_success)
+        {
+            break;
+        }
+
+        started++;
+    }
+
+    runParallelWorker(&job);
+
+    for (size_t i = 0; i < started; i++)
+    {
+        thrd_join(threads[i], NULL);
+    }
+
+    FREE(threads);
+    mtx_destroy(&job.lock);
+}
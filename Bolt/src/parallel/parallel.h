@@ -0,0 +1,11 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stddef.h>
+
+typedef void (*ParallelTask)(void *context, size_t index);
+
+size_t getProcessorCount(void);
+void runParallel(ParallelTask task, void *context, size_t count, size_t threadCount);
+
+#endif
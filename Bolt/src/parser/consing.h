@@ -0,0 +1,19 @@
+#ifndef CONSING_H
+#define CONSING_H
+
+#include <parsing.h>
+
+#define AST_TABLE_MIN_CAPACITY 64
+
+void initAstTable(AstTable *table);
+void resetAstTable(AstTable *table);
+void freeAstTable(AstTable *table);
+Ast *findAstTable(AstTable *table, Ast *ast);
+void insertAstTable(AstTable *table, Ast *ast);
+
+uint64_t hashLiteralAst(const TokenAttribute *value);
+uint64_t hashUnaryAst(TokenType op, const Ast *right);
+bool isAstConsable(const Ast *ast);
+bool astEquals(const Ast *a, const Ast *b);
+
+#endif
@@ -4,6 +4,13 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <tokenizer.h>
+#include <arena.h>
+#include <array.h>
+#include <hashmap.h>
+#include <types.h>
+
+#define PARALLEL_PARSE_MIN_TOKENS (64 * 1024)
+#define PARALLEL_PARSE_BATCHES_PER_THREAD 4
 
 typedef enum AstType
 {
@@ -14,11 +21,18 @@ typedef enum AstType
     AST_TYPE_ASSIGNMENT_EXPRESSION_NODE,
     AST_TYPE_CALL_EXPRESSION_NODE,
     AST_TYPE_CAST_EXPRESSION_NODE,
+    AST_TYPE_FUNCTION_DECLARATION_NODE,
+    AST_TYPE_SWITCH_STATEMENT_NODE,
+    AST_TYPE_CASE_LABEL_NODE,
+    AST_TYPE_BREAK_STATEMENT_NODE,
 } AstType;
 
 typedef struct Ast
 {
     AstType type;
+    uint32_t line;
+    uint64_t hash;
+    TypeId dataType;
 } Ast;
 
 typedef struct AstLiteralExpression
@@ -72,30 +86,112 @@ typedef struct AstCastExpression
     Ast *target;
 } AstCastExpression;
 
-typedef struct AstArray
+typedef struct AstFunctionDeclaration
+{
+    Ast info;
+    Token name;
+    uint32_t nameIndex;
+    uint32_t bodyStart;
+    uint32_t bodyEnd;
+    bool internal;
+    bool referenced;
+    bool parsed;
+    uint32_t bodyCount;
+    Ast **body;
+} AstFunctionDeclaration;
+
+typedef struct AstCaseLabel
+{
+    Ast info;
+    Ast *value;
+    uint32_t index;
+    uint64_t constant;
+    uint64_t key;
+} AstCaseLabel;
+
+typedef struct AstSwitchStatement
+{
+    Ast info;
+    Ast *selector;
+    TypeId selectorType;
+    uint32_t bodyCount;
+    Ast **body;
+    uint32_t caseCount;
+    AstCaseLabel **cases;
+    AstCaseLabel *defaultCase;
+} AstSwitchStatement;
+
+typedef struct AstBreakStatement
+{
+    Ast info;
+} AstBreakStatement;
+
+DECLARE_ARRAY(AstArray, Ast *, trees);
+
+typedef struct AstTable
+{
+    HashMap entries;
+} AstTable;
+
+typedef struct
+{
+    size_t count;
+    size_t capacity;
+    TokenType *operators;
+} ParserStack;
+
+typedef struct
+{
+    AstSwitchStatement *statement;
+    AstArray body;
+    AstArray cases;
+} ParserSwitch;
+
+typedef struct
 {
     size_t count;
     size_t capacity;
-    Ast **trees;
-} AstArray;
+    ParserSwitch *frames;
+} ParserSwitchStack;
 
 typedef struct
 {
     uint32_t current;
+    uint32_t end;
+    uint32_t threadCount;
+    bool printTrees;
+    bool hashCons;
+    bool lazyBodies;
+    bool hadError;
+    uint32_t errorLine;
     TokenArray tokens;
     AstArray trees;
+    ParserStack prefixes;
+    ParserSwitchStack switches;
+    AstTable nodes;
+    Arena arena;
 } Parser;
 
 void initParser(Parser *parser);
-void initAstArray(AstArray *array);
-void parseTokens(Parser *parser, Tokenizer *tokenizer);
-void growAstArray(AstArray *array);
-void appendAstArray(AstArray *array, Ast *ast);
+void resetParser(Parser *parser);
+void freeParser(Parser *parser);
+bool parseTokens(Parser *parser, Tokenizer *tokenizer);
+bool adoptParsedTrees(Parser *parser, TokenArray tokens, Ast **trees, size_t count);
+void parseTokensParallel(Parser *parser);
 
+void printParserTrees(Parser *parser);
 void printAst(Ast *ast);
 void printLiteralAst(AstLiteralExpression *ast);
-void printUnaryAst(AstUnaryExpression *ast);
-
+void printFunctionAst(AstFunctionDeclaration *ast);
+
+Ast *parseFunctionDefinition(Parser *parser, uint32_t nameIndex, uint32_t bodyStart);
+bool parseFunctionBody(Parser *parser, AstFunctionDeclaration *function);
+uint64_t hashFunctionName(const char *name);
+void resolveFunctionBodies(Parser *parser);
+bool beginSwitchStatement(Parser *parser);
+Ast *endSwitchStatement(Parser *parser);
+Ast *parseCaseLabel(Parser *parser);
+Ast *parseBreakStatement(Parser *parser);
 Ast *parseExpression(Parser *parser);
 Ast *parseLiteralExpression(Parser *parser);
 Ast *parseUnaryExpression(Parser *parser);
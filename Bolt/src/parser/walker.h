@@ -0,0 +1,44 @@
+#ifndef WALKER_H
+#define WALKER_H
+
+#include <parsing.h>
+
+#define AST_WALKER_INLINE_FRAMES 32
+
+typedef enum
+{
+    AST_WALK_CONTINUE,
+    AST_WALK_SKIP_CHILDREN,
+    AST_WALK_STOP,
+} AstWalkAction;
+
+typedef AstWalkAction (*AstVisitFunction)(Ast *ast, void *context);
+
+typedef struct
+{
+    AstVisitFunction pre;
+    AstVisitFunction post;
+} AstVisitor;
+
+typedef struct
+{
+    Ast *ast;
+    uint32_t nextChild;
+    bool descend;
+} AstWalkFrame;
+
+typedef struct
+{
+    size_t count;
+    size_t capacity;
+    AstWalkFrame *frames;
+    AstWalkFrame inlineFrames[AST_WALKER_INLINE_FRAMES];
+} AstWalker;
+
+void initAstWalker(AstWalker *walker);
+void freeAstWalker(AstWalker *walker);
+bool walkAst(AstWalker *walker, Ast *root, const AstVisitor *visitor, void *context);
+size_t getAstChildCount(Ast *ast);
+Ast *getAstChild(Ast *ast, size_t index);
+
+#endif
@@ -1,62 +1,152 @@
 #include <parsing.h>
 #include <memory.h>
 #include <array.h>
+#include <parallel.h>
+#include <walker.h>
+#include <consing.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
 
-void initParser(Parser *parser)
+DEFINE_ARRAY(AstArray, Ast *, trees)
+
+static void initParserStack(ParserStack *stack)
 {
-    parser->current = 0;
-    initAstArray(&parser->trees);
-    parser->tokens.capacity = 0;
-    parser->tokens.count = 0;
-    parser->tokens.tokens = NULL;
+    stack->count = 0;
+    stack->capacity = MIN_ARRAY_SIZE;
+    stack->operators = ALLOCATE(TokenType, MIN_ARRAY_SIZE);
 }
 
-void initAstArray(AstArray *array)
+static void pushParserStack(ParserStack *stack, TokenType op)
 {
-    array->count = 0;
-    array->capacity = MIN_ARRAY_SIZE;
-    array->trees = ALLOCATE(Ast *, MIN_ARRAY_SIZE);
+    if (stack->count >= stack->capacity)
+    {
+        size_t oldCapacity = stack->capacity;
+        stack->capacity = oldCapacity * ARRAY_GROW_FACTOR;
+        stack->operators = REALLOCATE(TokenType, stack->operators, oldCapacity, stack->capacity);
+    }
+
+    stack->operators[stack->count++] = op;
 }
 
-void parseTokens(Parser *parser, Tokenizer *tokenizer)
+static void initParserSwitchStack(ParserSwitchStack *stack)
 {
-    parser->tokens = tokenizer->tokens;
+    stack->count = 0;
+    stack->capacity = MIN_ARRAY_SIZE;
+    stack->frames = ALLOCATE(ParserSwitch, MIN_ARRAY_SIZE);
+}
 
-    while (!isAtEndParser(parser))
+static ParserSwitch *pushParserSwitch(ParserSwitchStack *stack)
+{
+    if (stack->count >= stack->capacity)
     {
-        Ast *ast = parseExpression(parser);
-        appendAstArray(&parser->trees, ast);
+        size_t oldCapacity = stack->capacity;
+        stack->capacity = oldCapacity * ARRAY_GROW_FACTOR;
+        stack->frames = REALLOCATE(ParserSwitch, stack->frames, oldCapacity, stack->capacity);
     }
 
-    for (size_t i = 0; i < parser->trees.count; i++)
+    return &stack->frames[stack->count++];
+}
+
+static void discardParserSwitches(ParserSwitchStack *stack, size_t base)
+{
+    while (stack->count > base)
     {
-        printAst(parser->trees.trees[i]);
-        printf("\n");
+        ParserSwitch *frame = &stack->frames[--stack->count];
+        freeAstArray(&frame->body);
+        freeAstArray(&frame->cases);
     }
 }
 
-void growAstArray(AstArray *array)
+static Ast *parserError(Parser *parser)
 {
-    size_t oldCapacity = array->capacity;
-    size_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
-    array->capacity = newCapacity;
-    array->trees = REALLOCATE(Ast *, array->trees, oldCapacity, newCapacity);
+    if (!parser->hadError)
+    {
+        parser->hadError = true;
+        parser->errorLine = peekParser(parser).line;
+    }
+
+    return NULL;
 }
 
-void appendAstArray(AstArray *array, Ast *ast)
+static Ast *internAst(Parser *parser, Ast *candidate, size_t size)
 {
-    if (array->count >= array->capacity - 1)
+    bool consable = parser->hashCons && isAstConsable(candidate);
+
+    if (consable)
+    {
+        Ast *existing = findAstTable(&parser->nodes, candidate);
+
+        if (existing != NULL)
+        {
+            return existing;
+        }
+    }
+
+    Ast *ast = arenaAllocate(&parser->arena, size);
+    memcpy(ast, candidate, size);
+
+    if (consable)
     {
-        growAstArray(array);
+        insertAstTable(&parser->nodes, ast);
     }
 
-    array->trees[array->count++] = ast;
+    return ast;
 }
 
-void printAst(Ast *ast)
+static Ast *newLiteralExpression(Parser *parser, TokenAttribute value, uint32_t line)
+{
+    AstLiteralExpression expression;
+    expression.info.type = AST_TYPE_LITERAL_EXPRESSION_NODE;
+    expression.info.line = line;
+    expression.info.hash = hashLiteralAst(&value);
+    expression.info.dataType = TYPE_ID_INVALID;
+    expression.value = value;
+
+    return internAst(parser, (Ast *)&expression, sizeof(expression));
+}
+
+static Ast *newUnaryExpression(Parser *parser, TokenType op, Ast *right)
 {
+    AstUnaryExpression expression;
+    expression.info.type = AST_TYPE_UNARY_EXPRESSION_NODE;
+    expression.info.line = right->line;
+    expression.info.hash = hashUnaryAst(op, right);
+    expression.info.dataType = TYPE_ID_INVALID;
+    expression.op = op;
+    expression.right = right;
+
+    return internAst(parser, (Ast *)&expression, sizeof(expression));
+}
+
+static void printUnaryOperator(TokenType op)
+{
+    switch (op)
+    {
+    case TOKEN_TYPE_MINUS:
+        printf("-");
+        break;
+
+    case TOKEN_TYPE_LOGICAL_NOT:
+        printf("!");
+        break;
+
+    default:
+        break;
+    }
+}
+
+static AstWalkAction printAstEnter(Ast *ast, void *context)
+{
+    bool *separate = context;
+
+    if (*separate)
+    {
+        printf(", ");
+        *separate = false;
+    }
+
     switch (ast->type)
     {
     case AST_TYPE_LITERAL_EXPRESSION_NODE:
@@ -64,12 +154,505 @@ void printAst(Ast *ast)
         break;
 
     case AST_TYPE_UNARY_EXPRESSION_NODE:
-        printUnaryAst((AstUnaryExpression *)ast);
+        printf("Unary(");
+        printUnaryOperator(((AstUnaryExpression *)ast)->op);
+        printf(", ");
+        break;
+
+    case AST_TYPE_SWITCH_STATEMENT_NODE:
+        printf("Switch(");
+        break;
+
+    case AST_TYPE_CASE_LABEL_NODE:
+        printf(((AstCaseLabel *)ast)->value != NULL ? "Case(" : "Default");
+        break;
+
+    case AST_TYPE_BREAK_STATEMENT_NODE:
+        printf("Break");
         break;
 
     default:
         break;
     }
+
+    return AST_WALK_CONTINUE;
+}
+
+static AstWalkAction printAstExit(Ast *ast, void *context)
+{
+    bool *separate = context;
+
+    if (ast->type == AST_TYPE_UNARY_EXPRESSION_NODE || ast->type == AST_TYPE_SWITCH_STATEMENT_NODE ||
+        (ast->type == AST_TYPE_CASE_LABEL_NODE && ((AstCaseLabel *)ast)->value != NULL))
+    {
+        printf(")");
+    }
+
+    *separate = true;
+    return AST_WALK_CONTINUE;
+}
+
+static bool isSpecifierToken(TokenType type)
+{
+    switch (type)
+    {
+    case TOKEN_TYPE_CHAR:
+    case TOKEN_TYPE_CONST:
+    case TOKEN_TYPE_DOUBLE:
+    case TOKEN_TYPE_ENUM:
+    case TOKEN_TYPE_EXTERN:
+    case TOKEN_TYPE_FLOAT:
+    case TOKEN_TYPE_INLINE:
+    case TOKEN_TYPE_INT:
+    case TOKEN_TYPE_LONG:
+    case TOKEN_TYPE_SHORT:
+    case TOKEN_TYPE_SIGNED:
+    case TOKEN_TYPE_STATIC:
+    case TOKEN_TYPE_STRUCT:
+    case TOKEN_TYPE_UNION:
+    case TOKEN_TYPE_UNSIGNED:
+    case TOKEN_TYPE_VOID:
+    case TOKEN_TYPE_VOLATILE:
+    case TOKEN_TYPE_IDENTIFIER:
+    case TOKEN_TYPE_STAR:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+static bool findFunctionDefinition(Parser *parser, uint32_t *nameIndex, uint32_t *bodyStart)
+{
+    Token *tokens = parser->tokens.tokens;
+    uint32_t i = parser->current;
+
+    while (i < parser->end && isSpecifierToken(tokens[i].type))
+    {
+        i++;
+    }
+
+    if (i - parser->current < 2 || i >= parser->end || tokens[i].type != TOKEN_TYPE_LEFT_PAREN ||
+        tokens[i - 1].type != TOKEN_TYPE_IDENTIFIER)
+    {
+        return false;
+    }
+
+    *nameIndex = i - 1;
+    int32_t depth = 0;
+
+    for (; i < parser->end; i++)
+    {
+        if (tokens[i].type == TOKEN_TYPE_LEFT_PAREN)
+        {
+            depth++;
+        }
+        else if (tokens[i].type == TOKEN_TYPE_RIGHT_PAREN && --depth == 0)
+        {
+            break;
+        }
+    }
+
+    if (i + 1 >= parser->end || tokens[i + 1].type != TOKEN_TYPE_LEFT_BRACE)
+    {
+        return false;
+    }
+
+    *bodyStart = i + 1;
+    return true;
+}
+
+static void parseItems(Parser *parser, AstArray *trees, bool topLevel)
+{
+    TokenType terminator[] = {TOKEN_TYPE_SEMICOLON};
+    TokenType closing[] = {TOKEN_TYPE_RIGHT_BRACE};
+    ParserSwitchStack *switches = &parser->switches;
+    size_t base = switches->count;
+    uint32_t nameIndex;
+    uint32_t bodyStart;
+
+    while (!isAtEndParser(parser))
+    {
+        bool nested = switches->count > base;
+        Ast *ast;
+
+        if (topLevel && !nested && findFunctionDefinition(parser, &nameIndex, &bodyStart))
+        {
+            ast = parseFunctionDefinition(parser, nameIndex, bodyStart);
+        }
+        else if (checkParser(parser, TOKEN_TYPE_SWITCH))
+        {
+            if (!beginSwitchStatement(parser))
+            {
+                break;
+            }
+
+            continue;
+        }
+        else if (nested && matchParser(parser, closing, 1))
+        {
+            ast = endSwitchStatement(parser);
+        }
+        else if (nested && (checkParser(parser, TOKEN_TYPE_CASE) || checkParser(parser, TOKEN_TYPE_DEFAULT)))
+        {
+            ast = parseCaseLabel(parser);
+        }
+        else if (nested && checkParser(parser, TOKEN_TYPE_BREAK))
+        {
+            ast = parseBreakStatement(parser);
+            matchParser(parser, terminator, 1);
+        }
+        else
+        {
+            ast = parseExpression(parser);
+            matchParser(parser, terminator, 1);
+        }
+
+        if (ast == NULL)
+        {
+            break;
+        }
+
+        appendAstArray(switches->count > base ? &switches->frames[switches->count - 1].body : trees, ast);
+    }
+
+    if (switches->count > base)
+    {
+        parserError(parser);
+        discardParserSwitches(switches, base);
+    }
+}
+
+static void parseTopLevel(Parser *parser)
+{
+    parseItems(parser, &parser->trees, true);
+}
+
+static uint64_t hashFunctionSlot(const void *slot)
+{
+    return hashFunctionName((*(AstFunctionDeclaration *const *)slot)->name.lexeme);
+}
+
+static AstFunctionDeclaration *findFunctionByName(const HashMap *functions, const char *name)
+{
+    HashMapProbe probe;
+    AstFunctionDeclaration **slot;
+
+    startHashMapProbe(functions, hashFunctionName(name), &probe);
+
+    while ((slot = nextHashMapMatch(functions, &probe)) != NULL)
+    {
+        if (strcmp((*slot)->name.lexeme, name) == 0)
+        {
+            return *slot;
+        }
+    }
+
+    return NULL;
+}
+
+static void markFunctionReferences(Parser *parser, uint32_t start, uint32_t end, const HashMap *functions,
+                                   AstArray *pending)
+{
+    Token *tokens = parser->tokens.tokens;
+
+    for (uint32_t i = start; i < end; i++)
+    {
+        if (tokens[i].type != TOKEN_TYPE_IDENTIFIER)
+        {
+            continue;
+        }
+
+        AstFunctionDeclaration *function = findFunctionByName(functions, tokens[i].lexeme);
+
+        if (function != NULL && !function->referenced)
+        {
+            function->referenced = true;
+            appendAstArray(pending, (Ast *)function);
+        }
+    }
+}
+
+static void appendBoundary(uint32_t **boundaries, size_t *count, size_t *capacity, uint32_t boundary)
+{
+    if (*count >= *capacity)
+    {
+        size_t oldCapacity = *capacity;
+        *capacity = oldCapacity * ARRAY_GROW_FACTOR;
+        *boundaries = REALLOCATE(uint32_t, *boundaries, oldCapacity, *capacity);
+    }
+
+    (*boundaries)[(*count)++] = boundary;
+}
+
+static size_t findTopLevelBoundaries(Parser *parser, uint32_t **boundaries)
+{
+    size_t count = 0;
+    size_t capacity = MIN_ARRAY_SIZE;
+    *boundaries = ALLOCATE(uint32_t, capacity);
+
+    Token *tokens = parser->tokens.tokens;
+    int32_t braceDepth = 0;
+    int32_t parenDepth = 0;
+    bool functionBody = false;
+
+    for (uint32_t i = parser->current; i < parser->end; i++)
+    {
+        bool boundary = false;
+
+        switch (tokens[i].type)
+        {
+        case TOKEN_TYPE_LEFT_PAREN:
+            parenDepth++;
+            break;
+
+        case TOKEN_TYPE_RIGHT_PAREN:
+            parenDepth--;
+            break;
+
+        case TOKEN_TYPE_LEFT_BRACE:
+            if (braceDepth == 0 && parenDepth == 0)
+            {
+                functionBody = i > parser->current && tokens[i - 1].type == TOKEN_TYPE_RIGHT_PAREN;
+            }
+
+            braceDepth++;
+            break;
+
+        case TOKEN_TYPE_RIGHT_BRACE:
+            braceDepth--;
+            boundary = braceDepth == 0 && parenDepth == 0 && functionBody;
+            break;
+
+        case TOKEN_TYPE_SEMICOLON:
+            boundary = braceDepth == 0 && parenDepth == 0;
+            break;
+
+        default:
+            break;
+        }
+
+        if (braceDepth < 0 || parenDepth < 0)
+        {
+            count = 0;
+            break;
+        }
+
+        if (boundary)
+        {
+            appendBoundary(boundaries, &count, &capacity, i + 1);
+        }
+    }
+
+    if (count == 0 || (*boundaries)[count - 1] != parser->end)
+    {
+        appendBoundary(boundaries, &count, &capacity, parser->end);
+    }
+
+    return count;
+}
+
+static void parseBatch(void *context, size_t index)
+{
+    parseTopLevel(&((Parser *)context)[index]);
+}
+
+void initParser(Parser *parser)
+{
+    parser->current = 0;
+    parser->end = 0;
+    parser->threadCount = (uint32_t)getProcessorCount();
+    parser->printTrees = true;
+    parser->hashCons = false;
+    parser->lazyBodies = false;
+    parser->hadError = false;
+    parser->errorLine = 0;
+    initAstArray(&parser->trees);
+    initParserStack(&parser->prefixes);
+    initParserSwitchStack(&parser->switches);
+    initAstTable(&parser->nodes);
+    initArena(&parser->arena, ARENA_BLOCK_SIZE);
+    parser->tokens.capacity = 0;
+    parser->tokens.count = 0;
+    parser->tokens.tokens = NULL;
+}
+
+void resetParser(Parser *parser)
+{
+    parser->current = 0;
+    parser->end = 0;
+    parser->hadError = false;
+    parser->errorLine = 0;
+    parser->trees.count = 0;
+    parser->prefixes.count = 0;
+    discardParserSwitches(&parser->switches, 0);
+    resetAstTable(&parser->nodes);
+    resetArena(&parser->arena);
+}
+
+void freeParser(Parser *parser)
+{
+    freeAstArray(&parser->trees);
+    FREE(parser->prefixes.operators);
+    parser->prefixes.operators = NULL;
+    parser->prefixes.count = 0;
+    parser->prefixes.capacity = 0;
+    discardParserSwitches(&parser->switches, 0);
+    FREE(parser->switches.frames);
+    parser->switches.frames = NULL;
+    parser->switches.capacity = 0;
+    freeAstTable(&parser->nodes);
+    freeArena(&parser->arena);
+}
+
+bool parseTokens(Parser *parser, Tokenizer *tokenizer)
+{
+    parser->tokens = tokenizer->tokens;
+    parser->end = (uint32_t)parser->tokens.count - 1;
+
+    if (parser->threadCount > 1 && parser->tokens.count >= PARALLEL_PARSE_MIN_TOKENS)
+    {
+        parseTokensParallel(parser);
+    }
+    else
+    {
+        parseTopLevel(parser);
+    }
+
+    if (parser->lazyBodies && !parser->hadError)
+    {
+        resolveFunctionBodies(parser);
+    }
+
+    if (parser->hadError)
+    {
+        return false;
+    }
+
+    printParserTrees(parser);
+    return true;
+}
+
+bool adoptParsedTrees(Parser *parser, TokenArray tokens, Ast **trees, size_t count)
+{
+    parser->tokens = tokens;
+    parser->current = 0;
+    parser->end = (uint32_t)tokens.count - 1;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        appendAstArray(&parser->trees, trees[i]);
+    }
+
+    if (parser->lazyBodies)
+    {
+        resolveFunctionBodies(parser);
+    }
+
+    for (size_t i = 0; !parser->lazyBodies && !parser->hadError && i < count; i++)
+    {
+        if (trees[i]->type == AST_TYPE_FUNCTION_DECLARATION_NODE)
+        {
+            parseFunctionBody(parser, (AstFunctionDeclaration *)trees[i]);
+        }
+    }
+
+    if (parser->hadError)
+    {
+        return false;
+    }
+
+    printParserTrees(parser);
+    return true;
+}
+
+void printParserTrees(Parser *parser)
+{
+    for (size_t i = 0; parser->printTrees && i < parser->trees.count; i++)
+    {
+        printAst(parser->trees.trees[i]);
+        printf("\n");
+    }
+}
+
+void parseTokensParallel(Parser *parser)
+{
+    uint32_t *boundaries;
+    size_t rangeCount = findTopLevelBoundaries(parser, &boundaries);
+    size_t batchCount = (size_t)parser->threadCount * PARALLEL_PARSE_BATCHES_PER_THREAD;
+
+    if (batchCount > rangeCount)
+    {
+        batchCount = rangeCount;
+    }
+
+    Parser *batches = ALLOCATE(Parser, batchCount);
+    uint32_t totalTokens = parser->end - parser->current;
+    uint32_t begin = parser->current;
+    size_t count = 0;
+
+    for (size_t i = 0; i < rangeCount; i++)
+    {
+        uint32_t target = parser->current + (uint32_t)((uint64_t)totalTokens * (count + 1) / batchCount);
+
+        if (boundaries[i] < target && i + 1 < rangeCount)
+        {
+            continue;
+        }
+
+        Parser *batch = &batches[count++];
+        initParser(batch);
+        batch->tokens = parser->tokens;
+        batch->current = begin;
+        batch->end = boundaries[i];
+        batch->threadCount = 1;
+        batch->hashCons = parser->hashCons;
+        batch->lazyBodies = parser->lazyBodies;
+        begin = boundaries[i];
+    }
+
+    FREE(boundaries);
+
+    runParallel(parseBatch, batches, count, parser->threadCount);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Parser *batchParser = &batches[i];
+
+        if (batchParser->hadError && !parser->hadError)
+        {
+            parser->hadError = true;
+            parser->errorLine = batchParser->errorLine;
+        }
+
+        for (size_t j = 0; j < batchParser->trees.count; j++)
+        {
+            appendAstArray(&parser->trees, batchParser->trees.trees[j]);
+        }
+
+        mergeArena(&parser->arena, &batchParser->arena);
+        freeParser(batchParser);
+    }
+
+    FREE(batches);
+    parser->current = parser->end;
+}
+
+void printAst(Ast *ast)
+{
+    if (ast->type == AST_TYPE_FUNCTION_DECLARATION_NODE)
+    {
+        printFunctionAst((AstFunctionDeclaration *)ast);
+        return;
+    }
+
+    AstWalker walker;
+    AstVisitor visitor = {printAstEnter, printAstExit};
+    bool separate = false;
+
+    initAstWalker(&walker);
+    walkAst(&walker, ast, &visitor, &separate);
+    freeAstWalker(&walker);
 }
 
 void printLiteralAst(AstLiteralExpression *ast)
@@ -78,7 +661,7 @@ void printLiteralAst(AstLiteralExpression *ast)
     switch (ast->value.type)
     {
     case TOKEN_ATTRIBUTE_TYPE_INT_LITERAL:
-        printf("%d)", ast->value.value.integer);
+        printf("%" PRIu64 ")", ast->value.value.integer);
         break;
 
     case TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL:
@@ -91,34 +674,27 @@ void printLiteralAst(AstLiteralExpression *ast)
     }
 }
 
-void printUnaryAst(AstUnaryExpression *ast)
+void printFunctionAst(AstFunctionDeclaration *ast)
 {
-    printf("Unary(");
+    printf("Function(%s", ast->name.lexeme);
 
-    switch (ast->op)
+    if (!ast->parsed)
     {
-    case TOKEN_TYPE_MINUS:
-        printf("-");
-        break;
-
-    case TOKEN_TYPE_LOGICAL_NOT:
-        printf("!");
-        break;
-
-    default:
-        break;
+        printf(", <unparsed>");
     }
 
-    printf(", ");
-
-    printAst((Ast *)ast->right);
+    for (uint32_t i = 0; i < ast->bodyCount; i++)
+    {
+        printf(", ");
+        printAst(ast->body[i]);
+    }
 
     printf(")");
 }
 
 bool isAtEndParser(Parser *parser)
 {
-    return parser->tokens.tokens[parser->current].type == TOKEN_TYPE_EOF;
+    return parser->current >= parser->end || parser->tokens.tokens[parser->current].type == TOKEN_TYPE_EOF;
 }
 
 bool checkParser(Parser *parser, TokenType type)
@@ -166,6 +742,284 @@ Token advanceParser(Parser *parser)
     return parser->tokens.tokens[parser->current];
 }
 
+Ast *parseFunctionDefinition(Parser *parser, uint32_t nameIndex, uint32_t bodyStart)
+{
+    Token *tokens = parser->tokens.tokens;
+    int32_t depth = 0;
+    uint32_t bodyEnd = bodyStart;
+
+    for (; bodyEnd < parser->end; bodyEnd++)
+    {
+        if (tokens[bodyEnd].type == TOKEN_TYPE_LEFT_BRACE)
+        {
+            depth++;
+        }
+        else if (tokens[bodyEnd].type == TOKEN_TYPE_RIGHT_BRACE && --depth == 0)
+        {
+            break;
+        }
+    }
+
+    if (bodyEnd >= parser->end)
+    {
+        parser->current = parser->end;
+        return parserError(parser);
+    }
+
+    AstFunctionDeclaration *function = ARENA_ALLOCATE(&parser->arena, AstFunctionDeclaration, 1);
+    function->info.type = AST_TYPE_FUNCTION_DECLARATION_NODE;
+    function->info.line = tokens[nameIndex].line;
+    function->info.hash = 0;
+    function->info.dataType = TYPE_ID_INVALID;
+    function->name = tokens[nameIndex];
+    function->nameIndex = nameIndex;
+    function->bodyStart = bodyStart;
+    function->bodyEnd = bodyEnd;
+    function->internal = false;
+    function->referenced = false;
+    function->parsed = false;
+    function->bodyCount = 0;
+    function->body = NULL;
+
+    for (uint32_t i = parser->current; i < nameIndex; i++)
+    {
+        if (tokens[i].type == TOKEN_TYPE_STATIC || tokens[i].type == TOKEN_TYPE_INLINE)
+        {
+            function->internal = true;
+        }
+    }
+
+    parser->current = bodyEnd + 1;
+
+    if (!parser->lazyBodies && !parseFunctionBody(parser, function))
+    {
+        return NULL;
+    }
+
+    return (Ast *)function;
+}
+
+bool parseFunctionBody(Parser *parser, AstFunctionDeclaration *function)
+{
+    if (function->parsed)
+    {
+        return true;
+    }
+
+    uint32_t current = parser->current;
+    uint32_t end = parser->end;
+    AstArray body;
+    initAstArray(&body);
+
+    parser->current = function->bodyStart + 1;
+    parser->end = function->bodyEnd;
+    parseItems(parser, &body, false);
+    parser->current = current;
+    parser->end = end;
+
+    function->body = copyAstArrayToArena(&body, &parser->arena);
+    function->bodyCount = (uint32_t)body.count;
+    function->parsed = true;
+    freeAstArray(&body);
+
+    return !parser->hadError;
+}
+
+uint64_t hashFunctionName(const char *name)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    while (*name != '\0')
+    {
+        hash ^= (uint8_t)*name++;
+        hash *= 0x100000001B3ull;
+    }
+
+    return hash;
+}
+
+void resolveFunctionBodies(Parser *parser)
+{
+    AstArray functions;
+    AstArray pending;
+    HashMap names;
+    initAstArray(&functions);
+    initAstArray(&pending);
+    initHashMap(&names, sizeof(AstFunctionDeclaration *), HASH_MAP_MIN_CAPACITY, hashFunctionSlot);
+
+    for (size_t i = 0; i < parser->trees.count; i++)
+    {
+        if (parser->trees.trees[i]->type == AST_TYPE_FUNCTION_DECLARATION_NODE)
+        {
+            AstFunctionDeclaration *function = (AstFunctionDeclaration *)parser->trees.trees[i];
+            appendAstArray(&functions, (Ast *)function);
+
+            if (findFunctionByName(&names, function->name.lexeme) == NULL)
+            {
+                *(AstFunctionDeclaration **)insertHashMap(&names, hashFunctionName(function->name.lexeme)) = function;
+            }
+
+            if (!function->internal && !function->referenced)
+            {
+                function->referenced = true;
+                appendAstArray(&pending, (Ast *)function);
+            }
+        }
+    }
+
+    AstFunctionDeclaration **declarations = (AstFunctionDeclaration **)functions.trees;
+    uint32_t cursor = 0;
+
+    for (size_t i = 0; i < functions.count; i++)
+    {
+        markFunctionReferences(parser, cursor, declarations[i]->nameIndex, &names, &pending);
+        markFunctionReferences(parser, declarations[i]->nameIndex + 1, declarations[i]->bodyStart, &names, &pending);
+        cursor = declarations[i]->bodyEnd + 1;
+    }
+
+    markFunctionReferences(parser, cursor, parser->end, &names, &pending);
+
+    while (pending.count > 0 && !parser->hadError)
+    {
+        AstFunctionDeclaration *function = (AstFunctionDeclaration *)pending.trees[--pending.count];
+        parseFunctionBody(parser, function);
+        markFunctionReferences(parser, function->bodyStart, function->bodyEnd, &names, &pending);
+    }
+
+    freeHashMap(&names);
+    freeAstArray(&functions);
+    freeAstArray(&pending);
+}
+
+bool beginSwitchStatement(Parser *parser)
+{
+    TokenType keyword[] = {TOKEN_TYPE_SWITCH};
+    TokenType opening[] = {TOKEN_TYPE_LEFT_PAREN};
+    TokenType closing[] = {TOKEN_TYPE_RIGHT_PAREN};
+    TokenType brace[] = {TOKEN_TYPE_LEFT_BRACE};
+
+    if (!matchParser(parser, keyword, 1))
+    {
+        parserError(parser);
+        return false;
+    }
+
+    uint32_t line = previous(parser).line;
+
+    if (!matchParser(parser, opening, 1))
+    {
+        parserError(parser);
+        return false;
+    }
+
+    Ast *selector = parseExpression(parser);
+
+    if (selector == NULL || !matchParser(parser, closing, 1) || !matchParser(parser, brace, 1))
+    {
+        parserError(parser);
+        return false;
+    }
+
+    AstSwitchStatement *statement = ARENA_ALLOCATE(&parser->arena, AstSwitchStatement, 1);
+    statement->info.type = AST_TYPE_SWITCH_STATEMENT_NODE;
+    statement->info.line = line;
+    statement->info.hash = 0;
+    statement->info.dataType = TYPE_ID_INVALID;
+    statement->selector = selector;
+    statement->selectorType = TYPE_ID_INVALID;
+    statement->bodyCount = 0;
+    statement->body = NULL;
+    statement->caseCount = 0;
+    statement->cases = NULL;
+    statement->defaultCase = NULL;
+
+    ParserSwitch *frame = pushParserSwitch(&parser->switches);
+    frame->statement = statement;
+    initAstArray(&frame->body);
+    initAstArray(&frame->cases);
+
+    return true;
+}
+
+Ast *endSwitchStatement(Parser *parser)
+{
+    ParserSwitch *frame = &parser->switches.frames[--parser->switches.count];
+    AstSwitchStatement *statement = frame->statement;
+
+    statement->body = copyAstArrayToArena(&frame->body, &parser->arena);
+    statement->bodyCount = (uint32_t)frame->body.count;
+    statement->cases = (AstCaseLabel **)copyAstArrayToArena(&frame->cases, &parser->arena);
+    statement->caseCount = (uint32_t)frame->cases.count;
+    freeAstArray(&frame->body);
+    freeAstArray(&frame->cases);
+
+    return (Ast *)statement;
+}
+
+Ast *parseCaseLabel(Parser *parser)
+{
+    TokenType keywords[] = {TOKEN_TYPE_CASE, TOKEN_TYPE_DEFAULT};
+    TokenType colon[] = {TOKEN_TYPE_COLON};
+
+    if (parser->switches.count == 0 || !matchParser(parser, keywords, 2))
+    {
+        return parserError(parser);
+    }
+
+    Token keyword = previous(parser);
+    ParserSwitch *frame = &parser->switches.frames[parser->switches.count - 1];
+    Ast *value = NULL;
+
+    if (keyword.type == TOKEN_TYPE_CASE && (value = parseExpression(parser)) == NULL)
+    {
+        return NULL;
+    }
+
+    if (!matchParser(parser, colon, 1))
+    {
+        return parserError(parser);
+    }
+
+    AstCaseLabel *label = ARENA_ALLOCATE(&parser->arena, AstCaseLabel, 1);
+    label->info.type = AST_TYPE_CASE_LABEL_NODE;
+    label->info.line = keyword.line;
+    label->info.hash = 0;
+    label->info.dataType = TYPE_ID_INVALID;
+    label->value = value;
+    label->index = (uint32_t)frame->cases.count;
+    label->constant = 0;
+    label->key = 0;
+
+    if (value != NULL)
+    {
+        appendAstArray(&frame->cases, (Ast *)label);
+    }
+    else if (frame->statement->defaultCase == NULL)
+    {
+        frame->statement->defaultCase = label;
+    }
+
+    return (Ast *)label;
+}
+
+Ast *parseBreakStatement(Parser *parser)
+{
+    TokenType keyword[] = {TOKEN_TYPE_BREAK};
+
+    if (parser->switches.count == 0 || !matchParser(parser, keyword, 1))
+    {
+        return parserError(parser);
+    }
+
+    AstBreakStatement *statement = ARENA_ALLOCATE(&parser->arena, AstBreakStatement, 1);
+    statement->info.type = AST_TYPE_BREAK_STATEMENT_NODE;
+    statement->info.line = previous(parser).line;
+    statement->info.hash = 0;
+    statement->info.dataType = TYPE_ID_INVALID;
+
+    return (Ast *)statement;
+}
+
 Ast *parseExpression(Parser *parser)
 {
     return parseUnaryExpression(parser);
@@ -173,39 +1027,48 @@ Ast *parseExpression(Parser *parser)
 
 Ast *parseLiteralExpression(Parser *parser)
 {
-    TokenType types[] = {TOKEN_TYPE_IDENTIFIER, TOKEN_TYPE_INT, TOKEN_TYPE_STRING_LITERAL};
+    TokenType types[] = {TOKEN_TYPE_IDENTIFIER, TOKEN_TYPE_INT_LITERAL, TOKEN_TYPE_FLOAT_LITERAL, TOKEN_TYPE_STRING_LITERAL};
 
-    if (matchParser(parser, types, 3))
+    if (matchParser(parser, types, 4))
     {
-        Ast ast = {AST_TYPE_LITERAL_EXPRESSION_NODE};
-        AstLiteralExpression *expression = ALLOCATE(AstLiteralExpression, 1);
-        expression->info = ast;
-        expression->value = previous(parser).attribute;
-
-        return (Ast *)expression;
+        Token literal = previous(parser);
+        return newLiteralExpression(parser, literal.attribute, literal.line);
     }
 
-    fprintf(stderr, "Error: Invalid expression.");
-    exit(EXIT_FAILURE);
+    return parserError(parser);
 }
 
 Ast *parseUnaryExpression(Parser *parser)
 {
-    TokenType types[] = {TOKEN_TYPE_MINUS, TOKEN_TYPE_LOGICAL_NOT};
+    TokenType types[] = {TOKEN_TYPE_MINUS, TOKEN_TYPE_LOGICAL_NOT, TOKEN_TYPE_LEFT_PAREN};
+    TokenType closing[] = {TOKEN_TYPE_RIGHT_PAREN};
+    ParserStack *prefixes = &parser->prefixes;
+    size_t base = prefixes->count;
 
-    if (matchParser(parser, types, 2))
+    while (matchParser(parser, types, 3))
     {
-        Token op = previous(parser);
-        Ast *right = parseUnaryExpression(parser);
-        AstUnaryExpression *expression = ALLOCATE(AstUnaryExpression, 1);
+        pushParserStack(prefixes, previous(parser).type);
+    }
 
-        Ast ast = {AST_TYPE_UNARY_EXPRESSION_NODE};
-        expression->info = ast;
-        expression->op = op.type;
-        expression->right = right;
+    Ast *expression = parseLiteralExpression(parser);
+
+    while (expression != NULL && prefixes->count > base)
+    {
+        TokenType op = prefixes->operators[--prefixes->count];
+
+        if (op == TOKEN_TYPE_LEFT_PAREN)
+        {
+            if (!matchParser(parser, closing, 1))
+            {
+                expression = parserError(parser);
+            }
+
+            continue;
+        }
 
-        return (Ast *)expression;
+        expression = newUnaryExpression(parser, op, expression);
     }
 
-    return parseLiteralExpression(parser);
+    prefixes->count = base;
+    return expression;
 }
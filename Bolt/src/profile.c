@@ -0,0 +1,174 @@
+#include <profile.h>
+#include <memory.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PROFILE_MIN_RECORDS 16
+
+static uint64_t hashProfileRecord(const void *slot)
+{
+    return ((const ProfileRecord *)slot)->key;
+}
+
+static uint32_t readProfileWord(const unsigned char *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static AstWalkAction countSwitchCounters(Ast *ast, void *context)
+{
+    uint32_t *count = context;
+
+    if (ast->type == AST_TYPE_SWITCH_STATEMENT_NODE)
+    {
+        *count += ((AstSwitchStatement *)ast)->caseCount + 1;
+    }
+
+    return ast->type == AST_TYPE_CASE_LABEL_NODE ? AST_WALK_SKIP_CHILDREN : AST_WALK_CONTINUE;
+}
+
+static const ProfileRecord *findProfileRecord(const ProfileData *profile, uint64_t key)
+{
+    HashMapProbe probe;
+    ProfileRecord *record;
+
+    startHashMapProbe(&profile->records, key, &probe);
+
+    while ((record = nextHashMapMatch(&profile->records, &probe)) != NULL)
+    {
+        if (record->key == key)
+        {
+            return record;
+        }
+    }
+
+    return NULL;
+}
+
+static bool parseProfileData(ProfileData *profile, const unsigned char *data, size_t size)
+{
+    if (size < PROFILE_HEADER_SIZE || readProfileWord(data) != PROFILE_MAGIC ||
+        readProfileWord(data + 4) != PROFILE_VERSION)
+    {
+        return false;
+    }
+
+    uint32_t functionCount = readProfileWord(data + 8);
+    size_t offset = PROFILE_HEADER_SIZE;
+
+    profile->counters = ALLOCATE(uint64_t, size / PROFILE_COUNTER_SIZE + 1);
+
+    for (uint32_t i = 0; i < functionCount; i++)
+    {
+        if (size - offset < PROFILE_RECORD_SIZE)
+        {
+            return false;
+        }
+
+        uint64_t key = readProfileWord(data + offset) | ((uint64_t)readProfileWord(data + offset + 4) << 32);
+        uint32_t counterCount = readProfileWord(data + offset + 8);
+        offset += PROFILE_RECORD_SIZE;
+
+        if ((size - offset) / PROFILE_COUNTER_SIZE < counterCount)
+        {
+            return false;
+        }
+
+        if (findProfileRecord(profile, key) == NULL)
+        {
+            ProfileRecord *record = insertHashMap(&profile->records, key);
+            record->key = key;
+            record->counterCount = counterCount;
+            record->offset = profile->counterCount;
+        }
+
+        for (uint32_t j = 0; j < counterCount; j++)
+        {
+            const unsigned char *counter = data + offset + (size_t)j * PROFILE_COUNTER_SIZE;
+            profile->counters[profile->counterCount++] =
+                readProfileWord(counter) | ((uint64_t)readProfileWord(counter + 4) << 32);
+        }
+
+        offset += (size_t)counterCount * PROFILE_COUNTER_SIZE;
+    }
+
+    return offset == size;
+}
+
+void initProfileData(ProfileData *profile)
+{
+    initHashMap(&profile->records, sizeof(ProfileRecord), PROFILE_MIN_RECORDS, hashProfileRecord);
+    profile->counterCount = 0;
+    profile->counters = NULL;
+}
+
+void freeProfileData(ProfileData *profile)
+{
+    freeHashMap(&profile->records);
+    FREE(profile->counters);
+    profile->counters = NULL;
+    profile->counterCount = 0;
+}
+
+bool loadProfileData(ProfileData *profile, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+
+    if (size < 0)
+    {
+        fclose(file);
+        return false;
+    }
+
+    unsigned char *data = ALLOCATE(unsigned char, (size_t)size + 1);
+    size_t read = fread(data, 1, (size_t)size, file);
+    fclose(file);
+
+    freeProfileData(profile);
+    initProfileData(profile);
+
+    bool loaded = read == (size_t)size && parseProfileData(profile, data, read);
+    FREE(data);
+
+    if (!loaded)
+    {
+        freeProfileData(profile);
+        initProfileData(profile);
+    }
+
+    return loaded;
+}
+
+const uint64_t *findProfileCounters(const ProfileData *profile, uint64_t key, uint32_t counterCount)
+{
+    const ProfileRecord *record = findProfileRecord(profile, key);
+
+    if (record == NULL || record->counterCount != counterCount)
+    {
+        return NULL;
+    }
+
+    return profile->counters + record->offset;
+}
+
+uint32_t countProfileCounters(AstFunctionDeclaration *function)
+{
+    AstWalker walker;
+    AstVisitor visitor = {countSwitchCounters, NULL};
+    uint32_t count = 1;
+
+    initAstWalker(&walker);
+    walkAst(&walker, (Ast *)function, &visitor, &count);
+    freeAstWalker(&walker);
+
+    return count;
+}
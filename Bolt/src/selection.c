@@ -0,0 +1,401 @@
+#include <selection.h>
+#include <assembling.h>
+#include <memory.h>
+
+DEFINE_ARRAY(SelectionStateArray, SelectionState, states)
+DEFINE_ARRAY(SelectionTaskArray, SelectionTask, tasks)
+DEFINE_ARRAY(SelectionReductionArray, SelectionReduction, reductions)
+
+static const SelectionRule selectionRules[] = {
+    {SELECTION_NONTERMINAL_NONE, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_NONE, 0,
+     SELECTION_COST_INFINITE, ASSEMBLY_CONSTANT_NONE, ""},
+
+    {SELECTION_NONTERMINAL_IMMEDIATE, SELECTION_OPERATOR_CONSTANT_I4, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_NONE, 0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+    {SELECTION_NONTERMINAL_IMMEDIATE, SELECTION_OPERATOR_CONSTANT_I8, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_NONE, 0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+    {SELECTION_NONTERMINAL_MEMORY, SELECTION_OPERATOR_CONSTANT_F4, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_NONE, 0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+    {SELECTION_NONTERMINAL_MEMORY, SELECTION_OPERATOR_CONSTANT_F8, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_NONE, 0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+    {SELECTION_NONTERMINAL_MEMORY, SELECTION_OPERATOR_CONSTANT_F10, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_NONE, 0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+    {SELECTION_NONTERMINAL_ADDRESS, SELECTION_OPERATOR_ADDRESS_P4, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_NONE, 0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_IMMEDIATE, 4, 1, ASSEMBLY_CONSTANT_NONE, "\tmov eax, %L\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_IMMEDIATE, 8, 2, ASSEMBLY_CONSTANT_NONE, "\tmov eax, %L\n\tmov edx, %H\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_IMMEDIATE,
+     4, 1, ASSEMBLY_CONSTANT_NONE, "\tpush dword %L\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_IMMEDIATE,
+     8, 2, ASSEMBLY_CONSTANT_NONE, "\tpush dword %H\n\tpush dword %L\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_REGISTER,
+     4, 1, ASSEMBLY_CONSTANT_NONE, "\tpush eax\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_REGISTER,
+     8, 2, ASSEMBLY_CONSTANT_NONE, "\tpush edx\n\tpush eax\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_ADDRESS, 4, 1, ASSEMBLY_CONSTANT_NONE, "\tmov eax, %M\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_ADDRESS, 4,
+     1, ASSEMBLY_CONSTANT_NONE, "\tpush dword %M\n"},
+    {SELECTION_NONTERMINAL_XMM, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_MEMORY, 4, 1,
+     ASSEMBLY_CONSTANT_NONE, "\tmovss xmm0, [%M]\n"},
+    {SELECTION_NONTERMINAL_XMM, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_MEMORY, 8, 1,
+     ASSEMBLY_CONSTANT_NONE, "\tmovsd xmm0, [%M]\n"},
+    {SELECTION_NONTERMINAL_X87, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_MEMORY, 12, 1,
+     ASSEMBLY_CONSTANT_NONE, "\tfld qword [%M]\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_MEMORY, 4,
+     1, ASSEMBLY_CONSTANT_NONE, "\tpush dword [%M]\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_MEMORY, 8,
+     2, ASSEMBLY_CONSTANT_NONE, "\tpush dword [%M + 4]\n\tpush dword [%M]\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_XMM, 4, 2,
+     ASSEMBLY_CONSTANT_NONE, "\tsub esp, 4\n\tmovss [esp], xmm0\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_XMM, 8, 2,
+     ASSEMBLY_CONSTANT_NONE, "\tsub esp, 8\n\tmovsd [esp], xmm0\n"},
+    {SELECTION_NONTERMINAL_STACK, SELECTION_OPERATOR_NONE, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_X87, 12, 2,
+     ASSEMBLY_CONSTANT_NONE, "\tsub esp, 12\n\tfstp tword [esp]\n"},
+
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NEGATE_I4, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_REGISTER, 0, 1, ASSEMBLY_CONSTANT_NONE, "\tneg eax\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NEGATE_I8, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_REGISTER, 0, 3, ASSEMBLY_CONSTANT_NONE, "\tneg eax\n\tadc edx, 0\n\tneg edx\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NEGATE_I4, SELECTION_OPERATOR_NEGATE_I4,
+     SELECTION_NONTERMINAL_REGISTER, 0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NEGATE_I8, SELECTION_OPERATOR_NEGATE_I8,
+     SELECTION_NONTERMINAL_REGISTER, 0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+    {SELECTION_NONTERMINAL_XMM, SELECTION_OPERATOR_NEGATE_F4, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_XMM, 0, 1,
+     ASSEMBLY_CONSTANT_FLOAT_SIGN_MASK, "\txorps xmm0, [float_sign_mask]\n"},
+    {SELECTION_NONTERMINAL_XMM, SELECTION_OPERATOR_NEGATE_F8, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_XMM, 0, 1,
+     ASSEMBLY_CONSTANT_DOUBLE_SIGN_MASK, "\txorpd xmm0, [double_sign_mask]\n"},
+    {SELECTION_NONTERMINAL_XMM, SELECTION_OPERATOR_NEGATE_F4, SELECTION_OPERATOR_NEGATE_F4, SELECTION_NONTERMINAL_XMM,
+     0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+    {SELECTION_NONTERMINAL_XMM, SELECTION_OPERATOR_NEGATE_F8, SELECTION_OPERATOR_NEGATE_F8, SELECTION_NONTERMINAL_XMM,
+     0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+    {SELECTION_NONTERMINAL_X87, SELECTION_OPERATOR_NEGATE_F10, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_X87, 0,
+     1, ASSEMBLY_CONSTANT_NONE, "\tfchs\n"},
+    {SELECTION_NONTERMINAL_X87, SELECTION_OPERATOR_NEGATE_F10, SELECTION_OPERATOR_NEGATE_F10,
+     SELECTION_NONTERMINAL_X87, 0, 0, ASSEMBLY_CONSTANT_NONE, ""},
+
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NOT_I4, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_REGISTER, 0, 3, ASSEMBLY_CONSTANT_NONE, "\ttest eax, eax\n\tsete al\n\tmovzx eax, al\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NOT_I8, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_REGISTER, 0, 3, ASSEMBLY_CONSTANT_NONE, "\tor eax, edx\n\tsete al\n\tmovzx eax, al\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NOT_I4, SELECTION_OPERATOR_NOT_I4,
+     SELECTION_NONTERMINAL_REGISTER, 0, 3, ASSEMBLY_CONSTANT_NONE, "\ttest eax, eax\n\tsetne al\n\tmovzx eax, al\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NOT_I4, SELECTION_OPERATOR_NOT_I8,
+     SELECTION_NONTERMINAL_REGISTER, 0, 3, ASSEMBLY_CONSTANT_NONE, "\tor eax, edx\n\tsetne al\n\tmovzx eax, al\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NOT_F4, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_XMM, 0,
+     6, ASSEMBLY_CONSTANT_NONE,
+     "\txorps xmm1, xmm1\n\tucomiss xmm0, xmm1\n\tsete al\n\tsetnp cl\n\tand al, cl\n\tmovzx eax, al\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NOT_F8, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_XMM, 0,
+     6, ASSEMBLY_CONSTANT_NONE,
+     "\txorpd xmm1, xmm1\n\tucomisd xmm0, xmm1\n\tsete al\n\tsetnp cl\n\tand al, cl\n\tmovzx eax, al\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NOT_F4, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_MEMORY, 0, 6, ASSEMBLY_CONSTANT_NONE,
+     "\txorps xmm0, xmm0\n\tucomiss xmm0, [%M]\n\tsete al\n\tsetnp cl\n\tand al, cl\n\tmovzx eax, al\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NOT_F8, SELECTION_OPERATOR_NONE,
+     SELECTION_NONTERMINAL_MEMORY, 0, 6, ASSEMBLY_CONSTANT_NONE,
+     "\txorpd xmm0, xmm0\n\tucomisd xmm0, [%M]\n\tsete al\n\tsetnp cl\n\tand al, cl\n\tmovzx eax, al\n"},
+    {SELECTION_NONTERMINAL_REGISTER, SELECTION_OPERATOR_NOT_F10, SELECTION_OPERATOR_NONE, SELECTION_NONTERMINAL_X87, 0,
+     7, ASSEMBLY_CONSTANT_NONE,
+     "\tfldz\n\tfucomip st0, st1\n\tfstp st0\n\tsete al\n\tsetnp cl\n\tand al, cl\n\tmovzx eax, al\n"},
+};
+
+static uint32_t getSelectionRuleCount(void)
+{
+    return (uint32_t)(sizeof(selectionRules) / sizeof(selectionRules[0]));
+}
+
+static uint32_t addSelectionCost(uint32_t a, uint32_t b)
+{
+    if (a == SELECTION_COST_INFINITE || b == SELECTION_COST_INFINITE)
+    {
+        return SELECTION_COST_INFINITE;
+    }
+
+    return a + b;
+}
+
+static SelectionOperator getFloatingOperator(TypeId type, SelectionOperator single, SelectionOperator wide,
+                                             SelectionOperator extended)
+{
+    if (type == TYPE_ID_FLOAT)
+    {
+        return single;
+    }
+
+    return type == TYPE_ID_LONG_DOUBLE ? extended : wide;
+}
+
+static uint32_t getOperandState(const SelectionStateArray *states, const SelectionRule *rule, uint32_t index)
+{
+    if (rule->root == SELECTION_OPERATOR_NONE || rule->operand == SELECTION_NONTERMINAL_NONE)
+    {
+        return index;
+    }
+
+    uint32_t child = states->states[index].child;
+    return rule->inner == SELECTION_OPERATOR_NONE ? child : states->states[child].child;
+}
+
+static uint32_t matchSelectionRule(const SelectionStateArray *states, const SelectionRule *rule, uint32_t index)
+{
+    const SelectionState *state = &states->states[index];
+
+    if (rule->root != state->op || (rule->size != 0 && rule->size != state->size))
+    {
+        return SELECTION_COST_INFINITE;
+    }
+
+    if (rule->operand == SELECTION_NONTERMINAL_NONE)
+    {
+        return rule->cost;
+    }
+
+    if (state->child == SELECTION_STATE_NONE)
+    {
+        return SELECTION_COST_INFINITE;
+    }
+
+    if (rule->inner != SELECTION_OPERATOR_NONE)
+    {
+        const SelectionState *child = &states->states[state->child];
+
+        if (child->op != rule->inner || child->child == SELECTION_STATE_NONE)
+        {
+            return SELECTION_COST_INFINITE;
+        }
+    }
+
+    uint32_t operand = getOperandState(states, rule, index);
+    return addSelectionCost(rule->cost, states->states[operand].cost[rule->operand]);
+}
+
+static void closeSelectionState(SelectionState *state)
+{
+    for (uint32_t pass = 0; pass < SELECTION_CHAIN_PASSES; pass++)
+    {
+        bool changed = false;
+
+        for (uint32_t i = 0; i < getSelectionRuleCount(); i++)
+        {
+            const SelectionRule *rule = &selectionRules[i];
+
+            if (rule->root != SELECTION_OPERATOR_NONE || rule->operand == SELECTION_NONTERMINAL_NONE ||
+                (rule->size != 0 && rule->size != state->size))
+            {
+                continue;
+            }
+
+            uint32_t cost = addSelectionCost(rule->cost, state->cost[rule->operand]);
+
+            if (cost < state->cost[rule->result])
+            {
+                state->cost[rule->result] = cost;
+                state->rule[rule->result] = (uint16_t)i;
+                changed = true;
+            }
+        }
+
+        if (!changed)
+        {
+            return;
+        }
+    }
+}
+
+static void labelSelectionState(SelectionStateArray *states, uint32_t index)
+{
+    SelectionState *state = &states->states[index];
+
+    for (uint32_t i = 0; i < SELECTION_NONTERMINAL_COUNT; i++)
+    {
+        state->cost[i] = SELECTION_COST_INFINITE;
+        state->rule[i] = 0;
+    }
+
+    if (state->op == SELECTION_OPERATOR_NONE)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < getSelectionRuleCount(); i++)
+    {
+        const SelectionRule *rule = &selectionRules[i];
+
+        if (rule->root == SELECTION_OPERATOR_NONE)
+        {
+            continue;
+        }
+
+        uint32_t cost = matchSelectionRule(states, rule, index);
+
+        if (cost < state->cost[rule->result])
+        {
+            state->cost[rule->result] = cost;
+            state->rule[rule->result] = (uint16_t)i;
+        }
+    }
+
+    closeSelectionState(state);
+}
+
+static void collectSelectionStates(InstructionSelector *selector, const TypeTable *types, Ast *ast)
+{
+    SelectionStateArray *states = &selector->states;
+    uint32_t parent = SELECTION_STATE_NONE;
+
+    states->count = 0;
+
+    while (ast != NULL)
+    {
+        SelectionState state;
+        state.ast = ast;
+        state.op = getSelectionOperator(types, ast);
+        state.size = getTypeSize(types, ast->dataType);
+        state.child = SELECTION_STATE_NONE;
+        state.label = 0;
+
+        if (parent != SELECTION_STATE_NONE)
+        {
+            states->states[parent].child = (uint32_t)states->count;
+        }
+
+        parent = (uint32_t)states->count;
+        appendSelectionStateArray(states, state);
+        ast = ast->type == AST_TYPE_UNARY_EXPRESSION_NODE ? ((AstUnaryExpression *)ast)->right : NULL;
+    }
+}
+
+static void reduceSelectionStates(InstructionSelector *selector, SelectionNonterminal goal)
+{
+    SelectionStateArray *states = &selector->states;
+    SelectionTaskArray *tasks = &selector->tasks;
+
+    selector->reductions.count = 0;
+    tasks->count = 0;
+    appendSelectionTaskArray(tasks, (SelectionTask){0, goal, false});
+
+    while (tasks->count > 0)
+    {
+        SelectionTask task = tasks->tasks[--tasks->count];
+        const SelectionRule *rule = &selectionRules[states->states[task.state].rule[task.nonterminal]];
+        uint32_t operand = getOperandState(states, rule, task.state);
+
+        if (task.expanded)
+        {
+            appendSelectionReductionArray(&selector->reductions, (SelectionReduction){rule, task.state, operand});
+            continue;
+        }
+
+        appendSelectionTaskArray(tasks, (SelectionTask){task.state, task.nonterminal, true});
+
+        if (rule->operand != SELECTION_NONTERMINAL_NONE)
+        {
+            appendSelectionTaskArray(tasks, (SelectionTask){operand, rule->operand, false});
+        }
+    }
+}
+
+void initInstructionSelector(InstructionSelector *selector)
+{
+    initSelectionStateArray(&selector->states);
+    initSelectionTaskArray(&selector->tasks);
+    initSelectionReductionArray(&selector->reductions);
+}
+
+void freeInstructionSelector(InstructionSelector *selector)
+{
+    freeSelectionStateArray(&selector->states);
+    freeSelectionTaskArray(&selector->tasks);
+    freeSelectionReductionArray(&selector->reductions);
+}
+
+bool selectInstructions(InstructionSelector *selector, const TypeTable *types, Ast *ast, SelectionNonterminal goal)
+{
+    collectSelectionStates(selector, types, ast);
+
+    for (size_t i = selector->states.count; i > 0; i--)
+    {
+        labelSelectionState(&selector->states, (uint32_t)(i - 1));
+    }
+
+    if (selector->states.states[0].cost[goal] == SELECTION_COST_INFINITE)
+    {
+        selector->reductions.count = 0;
+        return false;
+    }
+
+    reduceSelectionStates(selector, goal);
+    return true;
+}
+
+SelectionOperator getSelectionOperator(const TypeTable *types, Ast *ast)
+{
+    if (ast->dataType == TYPE_ID_INVALID)
+    {
+        return SELECTION_OPERATOR_NONE;
+    }
+
+    if (ast->type == AST_TYPE_LITERAL_EXPRESSION_NODE)
+    {
+        AstLiteralExpression *literal = (AstLiteralExpression *)ast;
+
+        switch (literal->value.type)
+        {
+        case TOKEN_ATTRIBUTE_TYPE_INT_LITERAL:
+            return getTypeSize(types, ast->dataType) == 8 ? SELECTION_OPERATOR_CONSTANT_I8
+                                                          : SELECTION_OPERATOR_CONSTANT_I4;
+
+        case TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL:
+            return getFloatingOperator(ast->dataType, SELECTION_OPERATOR_CONSTANT_F4, SELECTION_OPERATOR_CONSTANT_F8,
+                                       SELECTION_OPERATOR_CONSTANT_F10);
+
+        case TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL:
+            return SELECTION_OPERATOR_ADDRESS_P4;
+
+        default:
+            return SELECTION_OPERATOR_NONE;
+        }
+    }
+
+    if (ast->type != AST_TYPE_UNARY_EXPRESSION_NODE)
+    {
+        return SELECTION_OPERATOR_NONE;
+    }
+
+    AstUnaryExpression *unary = (AstUnaryExpression *)ast;
+    TypeId operand = unary->right->dataType;
+    bool floating = isFloatingType(types, operand);
+    bool wide = getTypeSize(types, operand) == 8;
+
+    if (operand == TYPE_ID_INVALID)
+    {
+        return SELECTION_OPERATOR_NONE;
+    }
+
+    switch (unary->op)
+    {
+    case TOKEN_TYPE_MINUS:
+        if (floating)
+        {
+            return getFloatingOperator(operand, SELECTION_OPERATOR_NEGATE_F4, SELECTION_OPERATOR_NEGATE_F8,
+                                       SELECTION_OPERATOR_NEGATE_F10);
+        }
+
+        return wide ? SELECTION_OPERATOR_NEGATE_I8 : SELECTION_OPERATOR_NEGATE_I4;
+
+    case TOKEN_TYPE_LOGICAL_NOT:
+        if (floating)
+        {
+            return getFloatingOperator(operand, SELECTION_OPERATOR_NOT_F4, SELECTION_OPERATOR_NOT_F8,
+                                       SELECTION_OPERATOR_NOT_F10);
+        }
+
+        return wide ? SELECTION_OPERATOR_NOT_I8 : SELECTION_OPERATOR_NOT_I4;
+
+    default:
+        return SELECTION_OPERATOR_NONE;
+    }
+}
@@ -0,0 +1,320 @@
+#include <semantic.h>
+#include <walker.h>
+#include <stdlib.h>
+
+typedef struct
+{
+    const TypeTable *types;
+    bool constant;
+    uint64_t value;
+} ConstantEvaluator;
+
+static TypeId getIntegerLiteralType(const TypeTable *types, uint64_t value, uint8_t flags)
+{
+    static const TypeId candidates[] = {
+        TYPE_ID_INT,
+        TYPE_ID_UNSIGNED_INT,
+        TYPE_ID_LONG,
+        TYPE_ID_UNSIGNED_LONG,
+        TYPE_ID_LONG_LONG,
+        TYPE_ID_UNSIGNED_LONG_LONG,
+    };
+
+    bool isUnsigned = (flags & TOKEN_LITERAL_FLAG_UNSIGNED) != 0;
+    bool isDecimal = (flags & TOKEN_LITERAL_FLAG_NON_DECIMAL) == 0;
+    uint8_t minimumRank = (flags & TOKEN_LITERAL_FLAG_LONG_LONG) != 0 ? getType(types, TYPE_ID_LONG_LONG)->rank
+                          : (flags & TOKEN_LITERAL_FLAG_LONG) != 0  ? getType(types, TYPE_ID_LONG)->rank
+                                                                     : getType(types, TYPE_ID_INT)->rank;
+
+    for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++)
+    {
+        const Type *type = getType(types, candidates[i]);
+        uint32_t bits = type->size * 8 - (type->isUnsigned ? 0 : 1);
+        uint64_t maximum = bits >= 64 ? UINT64_MAX : ((uint64_t)1 << bits) - 1;
+
+        if (type->rank < minimumRank || (isUnsigned && !type->isUnsigned) || (!isUnsigned && isDecimal && type->isUnsigned))
+        {
+            continue;
+        }
+
+        if (value <= maximum)
+        {
+            return candidates[i];
+        }
+    }
+
+    return TYPE_ID_UNSIGNED_LONG_LONG;
+}
+
+static TypeId reportSemanticError(Analyzer *analyzer, Ast *ast, const char *message)
+{
+    if (!analyzer->hadError)
+    {
+        analyzer->hadError = true;
+        analyzer->errorLine = ast->line;
+        analyzer->errorMessage = message;
+    }
+
+    return TYPE_ID_INVALID;
+}
+
+static AstWalkAction evaluateConstantNode(Ast *ast, void *context)
+{
+    ConstantEvaluator *evaluator = context;
+
+    if (!isIntegerType(evaluator->types, ast->dataType))
+    {
+        evaluator->constant = false;
+        return AST_WALK_STOP;
+    }
+
+    switch (ast->type)
+    {
+    case AST_TYPE_LITERAL_EXPRESSION_NODE:
+    {
+        AstLiteralExpression *literal = (AstLiteralExpression *)ast;
+
+        if (literal->value.type != TOKEN_ATTRIBUTE_TYPE_INT_LITERAL)
+        {
+            evaluator->constant = false;
+            return AST_WALK_STOP;
+        }
+
+        evaluator->value = truncateIntegerValue(evaluator->types, ast->dataType, literal->value.value.integer);
+        return AST_WALK_CONTINUE;
+    }
+
+    case AST_TYPE_UNARY_EXPRESSION_NODE:
+    {
+        AstUnaryExpression *unary = (AstUnaryExpression *)ast;
+        uint64_t operand = convertIntegerValue(evaluator->types, unary->right->dataType, ast->dataType, evaluator->value);
+
+        if (unary->op == TOKEN_TYPE_MINUS)
+        {
+            evaluator->value = truncateIntegerValue(evaluator->types, ast->dataType, 0 - operand);
+            return AST_WALK_CONTINUE;
+        }
+
+        if (unary->op == TOKEN_TYPE_LOGICAL_NOT)
+        {
+            evaluator->value = evaluator->value == 0 ? 1 : 0;
+            return AST_WALK_CONTINUE;
+        }
+
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    evaluator->constant = false;
+    return AST_WALK_STOP;
+}
+
+static int compareCaseLabels(const void *a, const void *b)
+{
+    uint64_t left = (*(AstCaseLabel *const *)a)->key;
+    uint64_t right = (*(AstCaseLabel *const *)b)->key;
+    return left < right ? -1 : left > right ? 1 : 0;
+}
+
+static AstWalkAction enterSemanticNode(Ast *ast, void *context)
+{
+    (void)context;
+    return ast->dataType != TYPE_ID_INVALID ? AST_WALK_SKIP_CHILDREN : AST_WALK_CONTINUE;
+}
+
+static AstWalkAction analyzeNode(Ast *ast, void *context)
+{
+    Analyzer *analyzer = context;
+
+    if (ast->dataType != TYPE_ID_INVALID)
+    {
+        return AST_WALK_CONTINUE;
+    }
+
+    switch (ast->type)
+    {
+    case AST_TYPE_LITERAL_EXPRESSION_NODE:
+        ast->dataType = analyzeLiteralExpression(analyzer, (AstLiteralExpression *)ast);
+        break;
+
+    case AST_TYPE_UNARY_EXPRESSION_NODE:
+        ast->dataType = analyzeUnaryExpression(analyzer, (AstUnaryExpression *)ast);
+        break;
+
+    case AST_TYPE_SWITCH_STATEMENT_NODE:
+        ast->dataType = analyzeSwitchStatement(analyzer, (AstSwitchStatement *)ast);
+        break;
+
+    case AST_TYPE_CASE_LABEL_NODE:
+    case AST_TYPE_BREAK_STATEMENT_NODE:
+        ast->dataType = TYPE_ID_VOID;
+        break;
+
+    default:
+        break;
+    }
+
+    return analyzer->hadError ? AST_WALK_STOP : AST_WALK_CONTINUE;
+}
+
+void initAnalyzer(Analyzer *analyzer)
+{
+    initTypeTable(&analyzer->types);
+    analyzer->hadError = false;
+    analyzer->errorLine = 0;
+    analyzer->errorMessage = NULL;
+}
+
+void resetAnalyzer(Analyzer *analyzer)
+{
+    analyzer->hadError = false;
+    analyzer->errorLine = 0;
+    analyzer->errorMessage = NULL;
+}
+
+void freeAnalyzer(Analyzer *analyzer)
+{
+    freeTypeTable(&analyzer->types);
+    resetAnalyzer(analyzer);
+}
+
+bool analyzeTrees(Analyzer *analyzer, AstArray *trees)
+{
+    AstWalker walker;
+    AstVisitor visitor = {enterSemanticNode, analyzeNode};
+    initAstWalker(&walker);
+
+    for (size_t i = 0; i < trees->count && !analyzer->hadError; i++)
+    {
+        walkAst(&walker, trees->trees[i], &visitor, analyzer);
+    }
+
+    freeAstWalker(&walker);
+    return !analyzer->hadError;
+}
+
+TypeId analyzeLiteralExpression(Analyzer *analyzer, AstLiteralExpression *ast)
+{
+    switch (ast->value.type)
+    {
+    case TOKEN_ATTRIBUTE_TYPE_INT_LITERAL:
+        return getIntegerLiteralType(&analyzer->types, ast->value.value.integer, ast->value.flags);
+
+    case TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL:
+        if ((ast->value.flags & TOKEN_LITERAL_FLAG_FLOAT) != 0)
+        {
+            return TYPE_ID_FLOAT;
+        }
+
+        return (ast->value.flags & TOKEN_LITERAL_FLAG_LONG) != 0 ? TYPE_ID_LONG_DOUBLE : TYPE_ID_DOUBLE;
+
+    case TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL:
+        return internPointerType(&analyzer->types, TYPE_ID_CHAR);
+
+    default:
+        return reportSemanticError(analyzer, (Ast *)ast, "Undeclared identifier");
+    }
+}
+
+TypeId analyzeUnaryExpression(Analyzer *analyzer, AstUnaryExpression *ast)
+{
+    TypeId operand = ast->right->dataType;
+
+    if (operand == TYPE_ID_INVALID)
+    {
+        return TYPE_ID_INVALID;
+    }
+
+    switch (ast->op)
+    {
+    case TOKEN_TYPE_MINUS:
+        if (!isArithmeticType(&analyzer->types, operand))
+        {
+            return reportSemanticError(analyzer, (Ast *)ast, "Invalid operand to unary '-'");
+        }
+
+        return promoteType(&analyzer->types, operand);
+
+    case TOKEN_TYPE_LOGICAL_NOT:
+        if (!isScalarType(&analyzer->types, operand))
+        {
+            return reportSemanticError(analyzer, (Ast *)ast, "Invalid operand to unary '!'");
+        }
+
+        return TYPE_ID_INT;
+
+    default:
+        return reportSemanticError(analyzer, (Ast *)ast, "Unsupported unary operator");
+    }
+}
+
+TypeId analyzeSwitchStatement(Analyzer *analyzer, AstSwitchStatement *ast)
+{
+    const TypeTable *types = &analyzer->types;
+
+    if (!isIntegerType(types, ast->selector->dataType))
+    {
+        return reportSemanticError(analyzer, (Ast *)ast, "Switch selector is not an integer");
+    }
+
+    ast->selectorType = promoteType(types, ast->selector->dataType);
+    const Type *selector = getType(types, ast->selectorType);
+    uint64_t bias = selector->isUnsigned ? 0 : (uint64_t)1 << (selector->size * 8 - 1);
+    uint32_t defaults = 0;
+
+    for (uint32_t i = 0; i < ast->bodyCount; i++)
+    {
+        Ast *item = ast->body[i];
+
+        if (item->type == AST_TYPE_CASE_LABEL_NODE && ((AstCaseLabel *)item)->value == NULL && ++defaults > 1)
+        {
+            return reportSemanticError(analyzer, item, "Multiple default labels in switch");
+        }
+    }
+
+    for (uint32_t i = 0; i < ast->caseCount; i++)
+    {
+        AstCaseLabel *label = ast->cases[i];
+        uint64_t value;
+
+        if (!evaluateIntegerConstant(analyzer, label->value, &value))
+        {
+            return reportSemanticError(analyzer, (Ast *)label, "Case label is not an integer constant");
+        }
+
+        label->constant = convertIntegerValue(types, label->value->dataType, ast->selectorType, value);
+        label->key = label->constant ^ bias;
+    }
+
+    if (ast->caseCount > 1)
+    {
+        qsort(ast->cases, ast->caseCount, sizeof(AstCaseLabel *), compareCaseLabels);
+    }
+
+    for (uint32_t i = 1; i < ast->caseCount; i++)
+    {
+        if (ast->cases[i]->key == ast->cases[i - 1]->key)
+        {
+            return reportSemanticError(analyzer, (Ast *)ast->cases[i], "Duplicate case value");
+        }
+    }
+
+    return TYPE_ID_VOID;
+}
+
+bool evaluateIntegerConstant(Analyzer *analyzer, Ast *ast, uint64_t *value)
+{
+    ConstantEvaluator evaluator = {&analyzer->types, true, 0};
+    AstVisitor visitor = {NULL, evaluateConstantNode};
+    AstWalker walker;
+
+    initAstWalker(&walker);
+    walkAst(&walker, ast, &visitor, &evaluator);
+    freeAstWalker(&walker);
+
+    *value = evaluator.value;
+    return evaluator.constant;
+}
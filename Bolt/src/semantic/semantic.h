@@ -0,0 +1,24 @@
+#ifndef SEMANTIC_H
+#define SEMANTIC_H
+
+#include <parsing.h>
+#include <types.h>
+
+typedef struct
+{
+    TypeTable types;
+    bool hadError;
+    uint32_t errorLine;
+    const char *errorMessage;
+} Analyzer;
+
+void initAnalyzer(Analyzer *analyzer);
+void resetAnalyzer(Analyzer *analyzer);
+void freeAnalyzer(Analyzer *analyzer);
+bool analyzeTrees(Analyzer *analyzer, AstArray *trees);
+TypeId analyzeLiteralExpression(Analyzer *analyzer, AstLiteralExpression *ast);
+TypeId analyzeUnaryExpression(Analyzer *analyzer, AstUnaryExpression *ast);
+TypeId analyzeSwitchStatement(Analyzer *analyzer, AstSwitchStatement *ast);
+bool evaluateIntegerConstant(Analyzer *analyzer, Ast *ast, uint64_t *value);
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef TYPES_H
+#define TYPES_H
+
+#include <hashmap.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TYPE_ID_INVALID 0
+#define TYPE_ID_VOID 1
+#define TYPE_ID_CHAR 2
+#define TYPE_ID_SIGNED_CHAR 3
+#define TYPE_ID_UNSIGNED_CHAR 4
+#define TYPE_ID_SHORT 5
+#define TYPE_ID_UNSIGNED_SHORT 6
+#define TYPE_ID_INT 7
+#define TYPE_ID_UNSIGNED_INT 8
+#define TYPE_ID_LONG 9
+#define TYPE_ID_UNSIGNED_LONG 10
+#define TYPE_ID_LONG_LONG 11
+#define TYPE_ID_UNSIGNED_LONG_LONG 12
+#define TYPE_ID_FLOAT 13
+#define TYPE_ID_DOUBLE 14
+#define TYPE_ID_LONG_DOUBLE 15
+#define TYPE_ID_BUILTIN_COUNT 16
+
+#define TYPE_POINTER_SIZE 4
+#define TYPE_TABLE_MIN_SLOTS 64
+
+typedef uint32_t TypeId;
+
+typedef enum
+{
+    TYPE_KIND_INVALID,
+    TYPE_KIND_VOID,
+    TYPE_KIND_INTEGER,
+    TYPE_KIND_FLOATING,
+    TYPE_KIND_POINTER,
+} TypeKind;
+
+typedef struct
+{
+    TypeKind kind;
+    uint8_t size;
+    uint8_t rank;
+    bool isUnsigned;
+    TypeId base;
+} Type;
+
+typedef struct
+{
+    size_t count;
+    size_t capacity;
+    Type *types;
+    HashMap slots;
+} TypeTable;
+
+void initTypeTable(TypeTable *table);
+void freeTypeTable(TypeTable *table);
+TypeId internType(TypeTable *table, Type type);
+TypeId internPointerType(TypeTable *table, TypeId base);
+const Type *getType(const TypeTable *table, TypeId id);
+uint32_t getTypeSize(const TypeTable *table, TypeId id);
+bool isIntegerType(const TypeTable *table, TypeId id);
+bool isFloatingType(const TypeTable *table, TypeId id);
+bool isArithmeticType(const TypeTable *table, TypeId id);
+bool isScalarType(const TypeTable *table, TypeId id);
+TypeId promoteType(const TypeTable *table, TypeId id);
+uint64_t truncateIntegerValue(const TypeTable *table, TypeId id, uint64_t value);
+uint64_t convertIntegerValue(const TypeTable *table, TypeId from, TypeId to, uint64_t value);
+
+#endif
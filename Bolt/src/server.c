@@ -0,0 +1,243 @@
+#include <server.h>
+#include <protocol.h>
+#include <compiler.h>
+#include <memory.h>
+#include <parallel.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+
+bool runCompileServer(const char *socketPath, uint32_t workerCount)
+{
+    (void)socketPath;
+    (void)workerCount;
+    fprintf(stderr, "Error: Compile server is not supported on this platform.\n");
+    return false;
+}
+
+#else
+
+#include <errno.h>
+#include <signal.h>
+#include <threads.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+typedef struct
+{
+    int listener;
+    Compiler compiler;
+} ServerWorker;
+
+static bool readExact(int fd, void *data, size_t size)
+{
+    uint8_t *bytes = (uint8_t *)data;
+
+    while (size > 0)
+    {
+        ssize_t count = read(fd, bytes, size);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count <= 0)
+        {
+            return false;
+        }
+
+        bytes += count;
+        size -= (size_t)count;
+    }
+
+    return true;
+}
+
+static bool writeExact(int fd, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    while (size > 0)
+    {
+        ssize_t count = write(fd, bytes, size);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count <= 0)
+        {
+            return false;
+        }
+
+        bytes += count;
+        size -= (size_t)count;
+    }
+
+    return true;
+}
+
+static bool sendCompileResponse(int connection, uint32_t status, const char *data, size_t length)
+{
+    CompileResponseHeader header;
+    header.magic = COMPILE_SERVER_MAGIC;
+    header.status = status;
+    header.length = (uint32_t)length;
+
+    return writeExact(connection, &header, sizeof(header)) && writeExact(connection, data, length);
+}
+
+static void serveCompileRequest(ServerWorker *worker, int connection)
+{
+    CompileRequestHeader header;
+
+    if (!readExact(connection, &header, sizeof(header)) || header.magic != COMPILE_SERVER_MAGIC ||
+        header.length > COMPILE_SERVER_MAX_PAYLOAD)
+    {
+        return;
+    }
+
+    char *payload = ALLOCATE(char, header.length + 1);
+
+    if (payload == NULL || !readExact(connection, payload, header.length))
+    {
+        FREE(payload);
+        return;
+    }
+
+    payload[header.length] = '\0';
+
+    Compiler *compiler = &worker->compiler;
+    uint32_t threadCount = header.threadCount > 0 ? header.threadCount : 1;
+    uint32_t processorCount = (uint32_t)getProcessorCount();
+
+    resetCompiler(compiler);
+    setCompilerThreadCount(compiler, threadCount < processorCount ? threadCount : processorCount);
+    setCompilerOptimizationLevel(compiler, header.level < OPTIMIZATION_LEVEL_2 ? (OptimizationLevel)header.level
+                                                                               : OPTIMIZATION_LEVEL_2);
+    setCompilerHashCons(compiler, (header.flags & COMPILE_REQUEST_FLAG_HASH_CONS) != 0);
+    setCompilerLazyBodies(compiler, (header.flags & COMPILE_REQUEST_FLAG_LAZY_BODIES) != 0);
+
+    CompilerStatus status = COMPILER_STATUS_OK;
+
+    if (header.kind == COMPILE_REQUEST_SOURCE_PATH)
+    {
+        status = setCompilerRoot(compiler, payload) ? compileCode(compiler) : compiler->status;
+    }
+    else
+    {
+        setCompilerSource(compiler, payload);
+        status = compileCode(compiler);
+    }
+
+    if (status == COMPILER_STATUS_OK)
+    {
+        AssemblyBuffer *assembly = &compiler->assembler.output;
+        sendCompileResponse(connection, status, assembly->data, assembly->count);
+    }
+    else
+    {
+        sendCompileResponse(connection, status, compiler->error, strlen(compiler->error));
+    }
+
+    FREE(payload);
+}
+
+static int runServerWorker(void *argument)
+{
+    ServerWorker *worker = (ServerWorker *)argument;
+
+    for (;;)
+    {
+        int connection = accept(worker->listener, NULL, NULL);
+
+        if (connection < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+
+            perror("Failed to accept connection");
+            return 1;
+        }
+
+        serveCompileRequest(worker, connection);
+        close(connection);
+    }
+
+    return 0;
+}
+
+bool runCompileServer(const char *socketPath, uint32_t workerCount)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (strlen(socketPath) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "Error: Socket path '%s' is too long.\n", socketPath);
+        return false;
+    }
+
+    strcpy(address.sun_path, socketPath);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (listener < 0)
+    {
+        perror("Failed to create socket");
+        return false;
+    }
+
+    unlink(socketPath);
+
+    if (bind(listener, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(listener, SOMAXCONN) < 0)
+    {
+        perror("Failed to listen on socket");
+        close(listener);
+        return false;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    if (workerCount == 0)
+    {
+        workerCount = 1;
+    }
+
+    ServerWorker *workers = ALLOCATE(ServerWorker, workerCount);
+    thrd_t *threads = ALLOCATE(thrd_t, workerCount);
+    uint32_t started = 0;
+
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        workers[i].listener = listener;
+        initCompiler(&workers[i].compiler);
+        workers[i].compiler.parser.printTrees = false;
+
+        if (thrd_create(&threads[started], runServerWorker, &workers[i]) == thrd_success)
+        {
+            started++;
+        }
+    }
+
+    for (uint32_t i = 0; i < started; i++)
+    {
+        thrd_join(threads[i], NULL);
+    }
+
+    close(listener);
+    unlink(socketPath);
+    FREE(threads);
+    FREE(workers);
+
+    return started > 0;
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdint.h>
+
+#define COMPILE_SERVER_MAGIC 0x544C4F42
+#define COMPILE_SERVER_DEFAULT_SOCKET "/tmp/boltc.sock"
+#define COMPILE_SERVER_MAX_PAYLOAD (256u * 1024 * 1024)
+
+typedef enum
+{
+    COMPILE_REQUEST_SOURCE_PATH,
+    COMPILE_REQUEST_INLINE_SOURCE,
+} CompileRequestKind;
+
+typedef enum
+{
+    COMPILE_REQUEST_FLAG_NONE = 0,
+    COMPILE_REQUEST_FLAG_HASH_CONS = 1 << 0,
+    COMPILE_REQUEST_FLAG_LAZY_BODIES = 1 << 1,
+} CompileRequestFlag;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t kind;
+    uint32_t threadCount;
+    uint32_t level;
+    uint32_t flags;
+    uint32_t length;
+} CompileRequestHeader;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t status;
+    uint32_t length;
+} CompileResponseHeader;
+
+#endif
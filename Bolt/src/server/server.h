@@ -0,0 +1,9 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+bool runCompileServer(const char *socketPath, uint32_t workerCount);
+
+#endif
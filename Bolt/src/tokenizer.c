@@ -1,24 +1,432 @@
 #include <token.h>
 #include <array.h>
 #include <memory.h>
+#include <parallel.h>
+#include <number.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include "tokenizer.h"
 
-static void initTokenArray(TokenArray *array)
+DEFINE_ARRAY(TokenArray, Token, tokens)
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(BOLT_NO_COMPUTED_GOTO)
+#define TOKENIZER_COMPUTED_GOTO
+#endif
+
+typedef enum
+{
+    CHARACTER_CLASS_INVALID,
+    CHARACTER_CLASS_WHITESPACE,
+    CHARACTER_CLASS_NEWLINE,
+    CHARACTER_CLASS_OPERATOR,
+    CHARACTER_CLASS_SLASH,
+    CHARACTER_CLASS_DOT,
+    CHARACTER_CLASS_DIGIT,
+    CHARACTER_CLASS_IDENTIFIER,
+    CHARACTER_CLASS_QUOTE,
+    CHARACTER_CLASS_COUNT,
+} CharacterClass;
+
+typedef enum
 {
-    array->count = 0;
-    array->capacity = MIN_ARRAY_SIZE;
-    array->tokens = ALLOCATE(Token, MIN_ARRAY_SIZE);
+    OPERATOR_STATE_NONE,
+    OPERATOR_STATE_PLUS,
+    OPERATOR_STATE_MINUS,
+    OPERATOR_STATE_STAR,
+    OPERATOR_STATE_SLASH,
+    OPERATOR_STATE_EQUAL,
+    OPERATOR_STATE_BANG,
+    OPERATOR_STATE_LESS,
+    OPERATOR_STATE_GREATER,
+    OPERATOR_STATE_AMPERSAND,
+    OPERATOR_STATE_PIPE,
+    OPERATOR_STATE_COUNT,
+} OperatorState;
+
+#define X CHARACTER_CLASS_INVALID
+#define W CHARACTER_CLASS_WHITESPACE
+#define N CHARACTER_CLASS_NEWLINE
+#define O CHARACTER_CLASS_OPERATOR
+#define S CHARACTER_CLASS_SLASH
+#define P CHARACTER_CLASS_DOT
+#define D CHARACTER_CLASS_DIGIT
+#define I CHARACTER_CLASS_IDENTIFIER
+#define Q CHARACTER_CLASS_QUOTE
+
+static const uint8_t characterClasses[256] = {
+    X, X, X, X, X, X, X, X, X, W, N, X, X, W, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    W, O, Q, O, X, X, O, X, O, O, O, O, O, O, P, S,
+    D, D, D, D, D, D, D, D, D, D, O, O, O, O, O, X,
+    X, I, I, I, I, I, I, I, I, I, I, I, I, I, I, I,
+    I, I, I, I, I, I, I, I, I, I, I, O, X, O, O, I,
+    X, I, I, I, I, I, I, I, I, I, I, I, I, I, I, I,
+    I, I, I, I, I, I, I, I, I, I, I, O, O, O, O, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+    X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+};
+
+#undef X
+#undef W
+#undef N
+#undef O
+#undef S
+#undef P
+#undef D
+#undef I
+#undef Q
+
+static const uint8_t singleTokens[256] = {
+    ['#'] = TOKEN_TYPE_PREPROCESSOR,
+    [','] = TOKEN_TYPE_COMMA,
+    [':'] = TOKEN_TYPE_COLON,
+    [';'] = TOKEN_TYPE_SEMICOLON,
+    ['['] = TOKEN_TYPE_LEFT_BRACKET,
+    [']'] = TOKEN_TYPE_RIGHT_BRACKET,
+    ['('] = TOKEN_TYPE_LEFT_PAREN,
+    [')'] = TOKEN_TYPE_RIGHT_PAREN,
+    ['{'] = TOKEN_TYPE_LEFT_BRACE,
+    ['}'] = TOKEN_TYPE_RIGHT_BRACE,
+    ['^'] = TOKEN_TYPE_BITWISE_XOR,
+    ['~'] = TOKEN_TYPE_BITWISE_NOT,
+    ['.'] = TOKEN_TYPE_DOT,
+    ['+'] = TOKEN_TYPE_PLUS,
+    ['-'] = TOKEN_TYPE_MINUS,
+    ['*'] = TOKEN_TYPE_STAR,
+    ['/'] = TOKEN_TYPE_SLASH,
+    ['='] = TOKEN_TYPE_EQUAL,
+    ['!'] = TOKEN_TYPE_LOGICAL_NOT,
+    ['<'] = TOKEN_TYPE_LESS,
+    ['>'] = TOKEN_TYPE_GREATER,
+    ['&'] = TOKEN_TYPE_BITWISE_AND,
+    ['|'] = TOKEN_TYPE_BITWISE_OR,
+};
+
+static const uint8_t operatorStates[256] = {
+    ['+'] = OPERATOR_STATE_PLUS,
+    ['-'] = OPERATOR_STATE_MINUS,
+    ['*'] = OPERATOR_STATE_STAR,
+    ['/'] = OPERATOR_STATE_SLASH,
+    ['='] = OPERATOR_STATE_EQUAL,
+    ['!'] = OPERATOR_STATE_BANG,
+    ['<'] = OPERATOR_STATE_LESS,
+    ['>'] = OPERATOR_STATE_GREATER,
+    ['&'] = OPERATOR_STATE_AMPERSAND,
+    ['|'] = OPERATOR_STATE_PIPE,
+};
+
+static const uint8_t operatorTransitions[OPERATOR_STATE_COUNT][OPERATOR_STATE_COUNT] = {
+    [OPERATOR_STATE_PLUS][OPERATOR_STATE_PLUS] = TOKEN_TYPE_PLUS_PLUS,
+    [OPERATOR_STATE_PLUS][OPERATOR_STATE_EQUAL] = TOKEN_TYPE_ADD_AND_ASSIGN,
+    [OPERATOR_STATE_MINUS][OPERATOR_STATE_MINUS] = TOKEN_TYPE_MINUS_MINUS,
+    [OPERATOR_STATE_MINUS][OPERATOR_STATE_EQUAL] = TOKEN_TYPE_SUBTRACT_AND_ASSIGN,
+    [OPERATOR_STATE_STAR][OPERATOR_STATE_EQUAL] = TOKEN_TYPE_MULTIPLY_AND_ASSIGN,
+    [OPERATOR_STATE_SLASH][OPERATOR_STATE_EQUAL] = TOKEN_TYPE_DIVIDE_AND_ASSIGN,
+    [OPERATOR_STATE_EQUAL][OPERATOR_STATE_EQUAL] = TOKEN_TYPE_EQUAL_EQUAL,
+    [OPERATOR_STATE_BANG][OPERATOR_STATE_EQUAL] = TOKEN_TYPE_NOT_EQUAL,
+    [OPERATOR_STATE_LESS][OPERATOR_STATE_EQUAL] = TOKEN_TYPE_LESS_EQUAL,
+    [OPERATOR_STATE_LESS][OPERATOR_STATE_LESS] = TOKEN_TYPE_LEFT_SHIFT,
+    [OPERATOR_STATE_GREATER][OPERATOR_STATE_EQUAL] = TOKEN_TYPE_GREATER_EQUAL,
+    [OPERATOR_STATE_GREATER][OPERATOR_STATE_GREATER] = TOKEN_TYPE_RIGHT_SHIFT,
+    [OPERATOR_STATE_AMPERSAND][OPERATOR_STATE_AMPERSAND] = TOKEN_TYPE_LOGICAL_AND,
+    [OPERATOR_STATE_PIPE][OPERATOR_STATE_PIPE] = TOKEN_TYPE_LOGICAL_OR,
+};
+
+#define KEYWORD_SLOT_COUNT 128
+#define KEYWORD_MAX_LENGTH 8
+#define KEYWORD_SLOT(first, last, length) (((first) * 3 + (last) * 13 + (length) * 4) & (KEYWORD_SLOT_COUNT - 1))
+#define KEYWORD(first, last, text, type)                                                                              \
+    [KEYWORD_SLOT(first, last, sizeof(text) - 1)] = {text, sizeof(text) - 1, type}
+
+/* KEYWORD_SLOT is a perfect hash over the keywords below, so a lookup is one probe and one memcmp. */
+static const struct
+{
+    const char *keyword;
+    uint32_t length;
+    TokenType type;
+} keywords[KEYWORD_SLOT_COUNT] = {
+    KEYWORD('a', 'o', "auto", TOKEN_TYPE_AUTO),
+    KEYWORD('b', 'k', "break", TOKEN_TYPE_BREAK),
+    KEYWORD('c', 'e', "case", TOKEN_TYPE_CASE),
+    KEYWORD('c', 'r', "char", TOKEN_TYPE_CHAR),
+    KEYWORD('c', 't', "const", TOKEN_TYPE_CONST),
+    KEYWORD('c', 'e', "continue", TOKEN_TYPE_CONTINUE),
+    KEYWORD('d', 't', "default", TOKEN_TYPE_DEFAULT),
+    KEYWORD('d', 'o', "do", TOKEN_TYPE_DO),
+    KEYWORD('d', 'e', "double", TOKEN_TYPE_DOUBLE),
+    KEYWORD('e', 'e', "else", TOKEN_TYPE_ELSE),
+    KEYWORD('e', 'm', "enum", TOKEN_TYPE_ENUM),
+    KEYWORD('e', 'n', "extern", TOKEN_TYPE_EXTERN),
+    KEYWORD('f', 't', "float", TOKEN_TYPE_FLOAT),
+    KEYWORD('f', 'r', "for", TOKEN_TYPE_FOR),
+    KEYWORD('g', 'o', "goto", TOKEN_TYPE_GOTO),
+    KEYWORD('i', 'f', "if", TOKEN_TYPE_IF),
+    KEYWORD('i', 'e', "inline", TOKEN_TYPE_INLINE),
+    KEYWORD('i', 't', "int", TOKEN_TYPE_INT),
+    KEYWORD('l', 'g', "long", TOKEN_TYPE_LONG),
+    KEYWORD('r', 'r', "register", TOKEN_TYPE_REGISTER),
+    KEYWORD('r', 'n', "return", TOKEN_TYPE_RETURN),
+    KEYWORD('s', 't', "short", TOKEN_TYPE_SHORT),
+    KEYWORD('s', 'd', "signed", TOKEN_TYPE_SIGNED),
+    KEYWORD('s', 'f', "sizeof", TOKEN_TYPE_SIZEOF),
+    KEYWORD('s', 'c', "static", TOKEN_TYPE_STATIC),
+    KEYWORD('s', 't', "struct", TOKEN_TYPE_STRUCT),
+    KEYWORD('s', 'h', "switch", TOKEN_TYPE_SWITCH),
+    KEYWORD('t', 'f', "typedef", TOKEN_TYPE_TYPEDEF),
+    KEYWORD('u', 'n', "union", TOKEN_TYPE_UNION),
+    KEYWORD('u', 'd', "unsigned", TOKEN_TYPE_UNSIGNED),
+    KEYWORD('v', 'd', "void", TOKEN_TYPE_VOID),
+    KEYWORD('v', 'e', "volatile", TOKEN_TYPE_VOLATILE),
+    KEYWORD('w', 'e', "while", TOKEN_TYPE_WHILE),
+};
+
+#undef KEYWORD
+
+static void freeTokenLexemes(TokenArray *array)
+{
+    for (size_t i = 0; i < array->count; i++)
+    {
+        if (array->tokens[i].type != TOKEN_TYPE_EOF)
+        {
+            FREE(array->tokens[i].lexeme);
+        }
+    }
 }
 
-static void growTokenArray(TokenArray *array)
+typedef struct
 {
-    size_t oldCapacity = array->capacity;
-    size_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
-    array->capacity = newCapacity;
-    array->tokens = REALLOCATE(Token, array->tokens, oldCapacity, newCapacity);
+    Tokenizer tokenizer;
+    uint32_t begin;
+    uint32_t end;
+} TokenizerChunk;
+
+static void reportScannerError(Tokenizer *tokenizer, ScannerStatus status, uint32_t line)
+{
+    if (tokenizer->status == SCANNER_STATUS_OK)
+    {
+        tokenizer->status = status;
+        tokenizer->errorLine = line;
+    }
+}
+
+#ifdef TOKENIZER_COMPUTED_GOTO
+#define TOKENIZER_TARGET(class) SCAN_##class:
+#define TOKENIZER_DISPATCH()                                                                                           \
+    if (position >= end)                                                                                               \
+    {                                                                                                                  \
+        goto finish;                                                                                                   \
+    }                                                                                                                  \
+    goto *dispatch[characterClasses[(uint8_t)source[position]]]
+#else
+#define TOKENIZER_TARGET(class) case CHARACTER_CLASS_##class:
+#define TOKENIZER_DISPATCH() continue
+#endif
+
+#define TOKENIZER_DISPATCH_AFTER_TOKEN()                                                                               \
+    if (tokenizer->tokens.count >= tokenLimit)                                                                         \
+    {                                                                                                                  \
+        goto finish;                                                                                                   \
+    }                                                                                                                  \
+    TOKENIZER_DISPATCH()
+
+static void scanTokensUntil(Tokenizer *tokenizer, uint32_t end, size_t tokenLimit)
+{
+    const char *source = tokenizer->source;
+    uint32_t sourceLength = tokenizer->sourceLength;
+    uint32_t position = tokenizer->start + tokenizer->length;
+
+#ifdef TOKENIZER_COMPUTED_GOTO
+    static const void *dispatch[CHARACTER_CLASS_COUNT] = {
+        [CHARACTER_CLASS_INVALID] = &&SCAN_INVALID,
+        [CHARACTER_CLASS_WHITESPACE] = &&SCAN_WHITESPACE,
+        [CHARACTER_CLASS_NEWLINE] = &&SCAN_NEWLINE,
+        [CHARACTER_CLASS_OPERATOR] = &&SCAN_OPERATOR,
+        [CHARACTER_CLASS_SLASH] = &&SCAN_SLASH,
+        [CHARACTER_CLASS_DOT] = &&SCAN_DOT,
+        [CHARACTER_CLASS_DIGIT] = &&SCAN_DIGIT,
+        [CHARACTER_CLASS_IDENTIFIER] = &&SCAN_IDENTIFIER,
+        [CHARACTER_CLASS_QUOTE] = &&SCAN_QUOTE,
+    };
+
+    TOKENIZER_DISPATCH();
+#else
+    while (position < end)
+    {
+        switch (characterClasses[(uint8_t)source[position]])
+        {
+#endif
+
+    TOKENIZER_TARGET(INVALID)
+    {
+        position++;
+        TOKENIZER_DISPATCH();
+    }
+
+    TOKENIZER_TARGET(WHITESPACE)
+    {
+        do
+        {
+            position++;
+        } while (characterClasses[(uint8_t)source[position]] == CHARACTER_CLASS_WHITESPACE);
+
+        TOKENIZER_DISPATCH();
+    }
+
+    TOKENIZER_TARGET(NEWLINE)
+    {
+        tokenizer->line++;
+        position++;
+        TOKENIZER_DISPATCH();
+    }
+
+    TOKENIZER_TARGET(SLASH)
+    {
+        if (source[position + 1] == '/')
+        {
+            const char *newline = memchr(&source[position], '\n', sourceLength - position);
+            position = newline != NULL ? (uint32_t)(newline - source) : sourceLength;
+            TOKENIZER_DISPATCH();
+        }
+
+        if (source[position + 1] == '*')
+        {
+            uint32_t line = tokenizer->line;
+            position += 2;
+
+            while (position < sourceLength && !(source[position] == '*' && source[position + 1] == '/'))
+            {
+                tokenizer->line += source[position] == '\n';
+                position++;
+            }
+
+            if (position >= sourceLength)
+            {
+                reportScannerError(tokenizer, SCANNER_STATUS_ERROR_UNTERMINATED_COMMENT, line);
+                TOKENIZER_DISPATCH();
+            }
+
+            position += 2;
+            TOKENIZER_DISPATCH();
+        }
+
+        goto scanOperator;
+    }
+
+    TOKENIZER_TARGET(DOT)
+    {
+        if (characterClasses[(uint8_t)source[position + 1]] == CHARACTER_CLASS_DIGIT)
+        {
+            goto scanNumber;
+        }
+
+        goto scanOperator;
+    }
+
+    TOKENIZER_TARGET(OPERATOR)
+    scanOperator:
+    {
+        uint8_t state = operatorStates[(uint8_t)source[position]];
+        TokenType type = (TokenType)operatorTransitions[state][operatorStates[(uint8_t)source[position + 1]]];
+        tokenizer->start = position;
+        tokenizer->length = 2;
+
+        if (type == TOKEN_TYPE_EOF)
+        {
+            type = (TokenType)singleTokens[(uint8_t)source[position]];
+            tokenizer->length = 1;
+        }
+
+        addToken(tokenizer, type);
+        position = tokenizer->start;
+        TOKENIZER_DISPATCH_AFTER_TOKEN();
+    }
+
+    TOKENIZER_TARGET(DIGIT)
+    scanNumber:
+    {
+        tokenizer->start = position;
+        tokenizer->length = 0;
+        numberLiteral(tokenizer);
+        position = tokenizer->start;
+        TOKENIZER_DISPATCH_AFTER_TOKEN();
+    }
+
+    TOKENIZER_TARGET(IDENTIFIER)
+    {
+        tokenizer->start = position;
+        tokenizer->length = 1;
+        identifier(tokenizer);
+        position = tokenizer->start;
+        TOKENIZER_DISPATCH_AFTER_TOKEN();
+    }
+
+    TOKENIZER_TARGET(QUOTE)
+    {
+        tokenizer->start = position;
+        tokenizer->length = 1;
+        stringLiteral(tokenizer);
+        position = tokenizer->start;
+        TOKENIZER_DISPATCH_AFTER_TOKEN();
+    }
+
+#ifndef TOKENIZER_COMPUTED_GOTO
+        }
+    }
+#endif
+
+finish:
+    tokenizer->start = position;
+    tokenizer->length = 0;
+}
+
+#undef TOKENIZER_TARGET
+#undef TOKENIZER_DISPATCH
+#undef TOKENIZER_DISPATCH_AFTER_TOKEN
+
+static void initTokenizerChunk(TokenizerChunk *chunk, Tokenizer *parent, uint32_t begin, uint32_t end)
+{
+    initTokenArray(&chunk->tokenizer.tokens);
+    chunk->tokenizer.line = 1;
+    chunk->tokenizer.start = begin;
+    chunk->tokenizer.length = 0;
+    chunk->tokenizer.source = parent->source;
+    chunk->tokenizer.sourceLength = parent->sourceLength;
+    chunk->tokenizer.threadCount = 1;
+    chunk->tokenizer.status = SCANNER_STATUS_OK;
+    chunk->tokenizer.errorLine = 0;
+    chunk->begin = begin;
+    chunk->end = end;
+}
+
+static ScannerStatus finishScan(Tokenizer *tokenizer)
+{
+    addTokenWithLexeme(tokenizer, TOKEN_TYPE_EOF, "EOF");
+    return tokenizer->status;
+}
+
+static void scanTokenChunk(void *context, size_t index)
+{
+    TokenizerChunk *chunk = &((TokenizerChunk *)context)[index];
+    scanTokensUntil(&chunk->tokenizer, chunk->end, SIZE_MAX);
+}
+
+static uint32_t findChunkBoundary(Tokenizer *tokenizer, uint32_t target)
+{
+    const char *newline = memchr(&tokenizer->source[target], '\n', tokenizer->sourceLength - target);
+
+    if (newline == NULL)
+    {
+        return tokenizer->sourceLength;
+    }
+
+    return (uint32_t)(newline - tokenizer->source) + 1;
 }
 
 void initTokenizer(Tokenizer *tokenizer)
@@ -27,6 +435,26 @@ void initTokenizer(Tokenizer *tokenizer)
     tokenizer->line = 1;
     tokenizer->start = 0;
     tokenizer->length = 0;
+    tokenizer->threadCount = (uint32_t)getProcessorCount();
+    tokenizer->status = SCANNER_STATUS_OK;
+    tokenizer->errorLine = 0;
+}
+
+void resetTokenizer(Tokenizer *tokenizer)
+{
+    freeTokenLexemes(&tokenizer->tokens);
+    tokenizer->tokens.count = 0;
+    tokenizer->line = 1;
+    tokenizer->start = 0;
+    tokenizer->length = 0;
+    tokenizer->status = SCANNER_STATUS_OK;
+    tokenizer->errorLine = 0;
+}
+
+void freeTokenizer(Tokenizer *tokenizer)
+{
+    freeTokenLexemes(&tokenizer->tokens);
+    freeTokenArray(&tokenizer->tokens);
 }
 
 void setTokenizerSourceCode(Tokenizer *tokenizer, const char *source)
@@ -38,276 +466,486 @@ void setTokenizerSourceCode(Tokenizer *tokenizer, const char *source)
 
 ScannerStatus scanToken(Tokenizer *tokenizer)
 {
-    tokenizer->start += tokenizer->length;
-    tokenizer->length = 0;
+    scanTokensUntil(tokenizer, tokenizer->sourceLength, tokenizer->tokens.count + 1);
 
-    char c = advance(tokenizer);
+    return tokenizer->status;
+}
 
-    switch (c)
+ScannerStatus scanTokens(Tokenizer *tokenizer)
+{
+    if (tokenizer->threadCount > 1 && tokenizer->sourceLength >= 2 * PARALLEL_SCAN_MIN_CHUNK_SIZE)
     {
-    case ' ':
-    case '\r':
-    case '\t':
-        break;
-    case '\n':
-        tokenizer->line++;
-        break;
+        return scanTokensParallel(tokenizer);
+    }
 
-    case '#':
-        addToken(tokenizer, TOKEN_TYPE_PREPROCESSOR);
-        break;
-    case ',':
-        addToken(tokenizer, TOKEN_TYPE_COMMA);
-        break;
-    case ':':
-        addToken(tokenizer, TOKEN_TYPE_COLON);
-        break;
-    case ';':
-        addToken(tokenizer, TOKEN_TYPE_SEMICOLON);
-        break;
-    case '[':
-        addToken(tokenizer, TOKEN_TYPE_LEFT_BRACKET);
-        break;
-    case ']':
-        addToken(tokenizer, TOKEN_TYPE_RIGHT_BRACKET);
-        break;
-    case '(':
-        addToken(tokenizer, TOKEN_TYPE_LEFT_PAREN);
-        break;
-    case ')':
-        addToken(tokenizer, TOKEN_TYPE_RIGHT_PAREN);
-        break;
-    case '{':
-        addToken(tokenizer, TOKEN_TYPE_LEFT_BRACE);
-        break;
-    case '}':
-        addToken(tokenizer, TOKEN_TYPE_RIGHT_BRACE);
-        break;
-    case '^':
-        addToken(tokenizer, TOKEN_TYPE_BITWISE_XOR);
-        break;
-    case '~':
-        addToken(tokenizer, TOKEN_TYPE_BITWISE_NOT);
-        break;
-    case '-':
-        if (match(tokenizer, '-'))
-        {
-            addToken(tokenizer, TOKEN_TYPE_MINUS_MINUS);
-            break;
-        }
-        else if (match(tokenizer, '='))
-        {
-            addToken(tokenizer, TOKEN_TYPE_SUBTRACT_AND_ASSIGN);
-            break;
-        }
-        else
-        {
-            addToken(tokenizer, TOKEN_TYPE_MINUS);
-            break;
-        }
+    scanTokensUntil(tokenizer, tokenizer->sourceLength, SIZE_MAX);
 
-    case '+':
-        if (match(tokenizer, '+'))
-        {
-            addToken(tokenizer, TOKEN_TYPE_PLUS_PLUS);
-            break;
-        }
-        else if (match(tokenizer, '='))
-        {
-            addToken(tokenizer, TOKEN_TYPE_ADD_AND_ASSIGN);
-            break;
-        }
-        else
-        {
-            addToken(tokenizer, TOKEN_TYPE_PLUS);
-            break;
-        }
+    return finishScan(tokenizer);
+}
 
-    case '*':
-        if (match(tokenizer, '='))
-        {
-            addToken(tokenizer, TOKEN_TYPE_MULTIPLY_AND_ASSIGN);
-            break;
-        }
-        else
-        {
-            addToken(tokenizer, TOKEN_TYPE_STAR);
-            break;
-        }
+ScannerStatus scanTokensParallel(Tokenizer *tokenizer)
+{
+    uint32_t position = tokenizer->start + tokenizer->length;
+    uint32_t remaining = tokenizer->sourceLength - position;
+    uint32_t chunkCount = remaining / PARALLEL_SCAN_MIN_CHUNK_SIZE;
 
-    case '/':
-        if (match(tokenizer, '='))
-        {
-            addToken(tokenizer, TOKEN_TYPE_DIVIDE_AND_ASSIGN);
-            break;
-        }
-        else
-        {
-            addToken(tokenizer, TOKEN_TYPE_SLASH);
-            break;
-        }
+    if (chunkCount > tokenizer->threadCount)
+    {
+        chunkCount = tokenizer->threadCount;
+    }
 
-    case '=':
-        if (match(tokenizer, '='))
+    if (chunkCount == 0)
+    {
+        chunkCount = 1;
+    }
+
+    TokenizerChunk *chunks = ALLOCATE(TokenizerChunk, chunkCount);
+    size_t count = 0;
+    uint32_t begin = position;
+
+    while (count < chunkCount && begin < tokenizer->sourceLength)
+    {
+        uint32_t end = tokenizer->sourceLength;
+
+        if (count + 1 < chunkCount)
         {
-            addToken(tokenizer, TOKEN_TYPE_EQUAL_EQUAL);
-            break;
+            uint32_t target = position + (uint32_t)((uint64_t)remaining * (count + 1) / chunkCount);
+            end = findChunkBoundary(tokenizer, target > begin ? target : begin);
         }
-        else
+
+        initTokenizerChunk(&chunks[count++], tokenizer, begin, end);
+        begin = end;
+    }
+
+    runParallel(scanTokenChunk, chunks, count, tokenizer->threadCount);
+
+    size_t tokenCount = 0;
+    uint32_t scanned = position;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        TokenizerChunk *chunk = &chunks[i];
+
+        if (chunk->begin != scanned)
         {
-            addToken(tokenizer, TOKEN_TYPE_EQUAL);
-            break;
+            freeTokenLexemes(&chunk->tokenizer.tokens);
+            freeTokenArray(&chunk->tokenizer.tokens);
+            initTokenizerChunk(chunk, tokenizer, scanned, chunk->end);
+            scanTokensUntil(&chunk->tokenizer, chunk->end, SIZE_MAX);
         }
 
-    case '!':
-        if (match(tokenizer, '='))
+        scanned = chunk->tokenizer.start + chunk->tokenizer.length;
+        tokenCount += chunk->tokenizer.tokens.count;
+    }
+
+    TokenArray *tokens = &tokenizer->tokens;
+    reserveTokenArray(tokens, tokens->count + tokenCount + 2);
+    uint32_t lineOffset = tokenizer->line - 1;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        TokenArray *chunkTokens = &chunks[i].tokenizer.tokens;
+
+        if (chunks[i].tokenizer.status != SCANNER_STATUS_OK)
         {
-            addToken(tokenizer, TOKEN_TYPE_NOT_EQUAL);
-            break;
+            reportScannerError(tokenizer, chunks[i].tokenizer.status, chunks[i].tokenizer.errorLine + lineOffset);
         }
-        else
+
+        for (size_t j = 0; j < chunkTokens->count; j++)
         {
-            addToken(tokenizer, TOKEN_TYPE_LOGICAL_NOT);
-            break;
+            Token token = chunkTokens->tokens[j];
+            token.line += lineOffset;
+            tokens->tokens[tokens->count++] = token;
         }
 
-    case '>':
-        if (match(tokenizer, '='))
+        lineOffset += chunks[i].tokenizer.line - 1;
+        freeTokenArray(chunkTokens);
+    }
+
+    FREE(chunks);
+
+    tokenizer->line = lineOffset + 1;
+    tokenizer->start = scanned;
+    tokenizer->length = 0;
+
+    return finishScan(tokenizer);
+}
+
+typedef struct
+{
+    uint64_t significand;
+    int64_t exponent;
+    uint32_t digits;
+    bool truncated;
+} NumberSignificand;
+
+static uint32_t digitValue(char c)
+{
+    if (isDigit(c))
+    {
+        return (uint32_t)(c - '0');
+    }
+
+    if (c >= 'a' && c <= 'f')
+    {
+        return (uint32_t)(c - 'a' + 10);
+    }
+
+    return (uint32_t)(c - 'A' + 10);
+}
+
+static void appendSignificandDigit(NumberSignificand *number, uint32_t digit, uint32_t base, uint32_t maxDigits, int32_t scale, bool fraction)
+{
+    if (number->significand == 0 && digit == 0)
+    {
+        if (fraction)
         {
-            addToken(tokenizer, TOKEN_TYPE_GREATER_EQUAL);
-            break;
+            number->exponent -= scale;
         }
-        else if (match(tokenizer, '>'))
+
+        return;
+    }
+
+    if (number->digits < maxDigits)
+    {
+        number->significand = number->significand * base + digit;
+        number->digits++;
+
+        if (fraction)
         {
-            addToken(tokenizer, TOKEN_TYPE_RIGHT_SHIFT);
-            break;
+            number->exponent -= scale;
         }
-        else
+
+        return;
+    }
+
+    if (!fraction)
+    {
+        number->exponent += scale;
+    }
+
+    if (digit != 0)
+    {
+        number->truncated = true;
+    }
+}
+
+static bool scanExponent(Tokenizer *tokenizer, int64_t *exponent)
+{
+    char next = peekNext(tokenizer);
+    char sign = next;
+
+    if (!isDigit(next) && !((sign == '+' || sign == '-') && isDigit(tokenizer->source[tokenizer->start + tokenizer->length + 2])))
+    {
+        return false;
+    }
+
+    const char *source = tokenizer->source;
+    uint32_t end = tokenizer->start + tokenizer->length + 1;
+    int64_t negative = sign == '-' ? -1 : 1;
+    int64_t value = 0;
+
+    end += sign == '+' || sign == '-';
+
+    while (characterClasses[(uint8_t)source[end]] == CHARACTER_CLASS_DIGIT)
+    {
+        int64_t digit = source[end++] - '0';
+
+        if (value < 100000000)
         {
-            addToken(tokenizer, TOKEN_TYPE_GREATER);
-            break;
+            value = value * 10 + digit;
         }
+    }
+
+    tokenizer->length = end - tokenizer->start;
+    *exponent += negative * value;
+    return true;
+}
+
+static uint8_t scanIntegerSuffix(Tokenizer *tokenizer)
+{
+    uint8_t flags = TOKEN_LITERAL_FLAG_NONE;
+
+    for (int i = 0; i < 2; i++)
+    {
+        char c = peek(tokenizer);
 
-    case '<':
-        if (match(tokenizer, '='))
+        if ((c == 'u' || c == 'U') && !(flags & TOKEN_LITERAL_FLAG_UNSIGNED))
         {
-            addToken(tokenizer, TOKEN_TYPE_LESS_EQUAL);
-            break;
+            advance(tokenizer);
+            flags |= TOKEN_LITERAL_FLAG_UNSIGNED;
         }
-        else if (match(tokenizer, '<'))
+        else if ((c == 'l' || c == 'L') && !(flags & (TOKEN_LITERAL_FLAG_LONG | TOKEN_LITERAL_FLAG_LONG_LONG)))
         {
-            addToken(tokenizer, TOKEN_TYPE_LEFT_SHIFT);
-            break;
+            advance(tokenizer);
+            flags |= match(tokenizer, c) ? TOKEN_LITERAL_FLAG_LONG_LONG : TOKEN_LITERAL_FLAG_LONG;
         }
         else
         {
-            addToken(tokenizer, TOKEN_TYPE_LESS);
             break;
         }
+    }
 
-    case '&':
-        if (match(tokenizer, '&'))
-        {
-            addToken(tokenizer, TOKEN_TYPE_LOGICAL_AND);
-            break;
-        }
-        else
-        {
-            addToken(tokenizer, TOKEN_TYPE_BITWISE_AND);
-            break;
-        }
+    return flags;
+}
 
-    case '|':
-        if (match(tokenizer, '|'))
-        {
-            addToken(tokenizer, TOKEN_TYPE_LOGICAL_OR);
-            break;
-        }
-        else
+static bool integerLiteral(Tokenizer *tokenizer, TokenAttribute *attribute, uint64_t value, bool decimal)
+{
+    attribute->type = TOKEN_ATTRIBUTE_TYPE_INT_LITERAL;
+    attribute->value.integer = value;
+    attribute->flags = scanIntegerSuffix(tokenizer);
+
+    if (!decimal)
+    {
+        attribute->flags |= TOKEN_LITERAL_FLAG_NON_DECIMAL;
+    }
+
+    return true;
+}
+
+static bool floatLiteral(Tokenizer *tokenizer, TokenAttribute *attribute, const NumberSignificand *number, bool hex)
+{
+    const char *text = &tokenizer->source[tokenizer->start];
+
+    attribute->type = TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL;
+    attribute->flags = TOKEN_LITERAL_FLAG_NONE;
+
+    if (match(tokenizer, 'f') || match(tokenizer, 'F'))
+    {
+        float single;
+        bool converted = hex ? hexToFloat(number->significand, number->exponent, number->truncated, &single)
+                             : decimalToFloat(number->significand, number->exponent, number->truncated, &single);
+
+        attribute->flags = TOKEN_LITERAL_FLAG_FLOAT;
+        attribute->value.floating = converted ? single : strtof(text, NULL);
+        return true;
+    }
+
+    if (match(tokenizer, 'l') || match(tokenizer, 'L'))
+    {
+        attribute->flags = TOKEN_LITERAL_FLAG_LONG;
+    }
+
+    double *floating = &attribute->value.floating;
+    bool converted = hex ? hexToDouble(number->significand, number->exponent, number->truncated, floating)
+                         : decimalToDouble(number->significand, number->exponent, number->truncated, floating);
+
+    if (!converted)
+    {
+        attribute->value.floating = strtod(text, NULL);
+    }
+
+    return true;
+}
+
+static bool decimalNumberLiteral(Tokenizer *tokenizer, TokenAttribute *attribute)
+{
+    const char *source = tokenizer->source;
+    uint32_t end = tokenizer->start + tokenizer->length;
+    NumberSignificand number = {0, 0, 0, false};
+    uint64_t integer = 0;
+    uint64_t octal = 0;
+    bool overflow = false;
+    bool octalOverflow = false;
+    bool octalValid = true;
+    bool leadingZero = source[end] == '0';
+    bool isFloat = false;
+
+    while (characterClasses[(uint8_t)source[end]] == CHARACTER_CLASS_DIGIT)
+    {
+        uint32_t digit = (uint32_t)(source[end++] - '0');
+
+        overflow |= integer > (UINT64_MAX - digit) / 10;
+        integer = integer * 10 + digit;
+        octalValid &= digit < 8;
+        octalOverflow |= octal > (UINT64_MAX >> 3);
+        octal = octal * 8 + digit;
+        appendSignificandDigit(&number, digit, 10, DECIMAL_SIGNIFICAND_DIGITS, 1, false);
+    }
+
+    if (source[end] == '.')
+    {
+        isFloat = true;
+        end++;
+
+        while (characterClasses[(uint8_t)source[end]] == CHARACTER_CLASS_DIGIT)
         {
-            addToken(tokenizer, TOKEN_TYPE_BITWISE_OR);
-            break;
+            uint32_t digit = (uint32_t)(source[end++] - '0');
+            appendSignificandDigit(&number, digit, 10, DECIMAL_SIGNIFICAND_DIGITS, 1, true);
         }
+    }
 
-    case '"':
-        stringLiteral(tokenizer);
-        break;
+    tokenizer->length = end - tokenizer->start;
+
+    if (check(tokenizer, 'e') || check(tokenizer, 'E'))
+    {
+        isFloat |= scanExponent(tokenizer, &number.exponent);
+    }
+
+    if (isFloat)
+    {
+        return floatLiteral(tokenizer, attribute, &number, false);
+    }
+
+    if (leadingZero)
+    {
+        return octalValid && !octalOverflow && integerLiteral(tokenizer, attribute, octal, false);
+    }
+
+    return !overflow && integerLiteral(tokenizer, attribute, integer, true);
+}
+
+static bool hexNumberLiteral(Tokenizer *tokenizer, TokenAttribute *attribute)
+{
+    const char *source = tokenizer->source;
+    uint32_t end = tokenizer->start + tokenizer->length;
+    NumberSignificand number = {0, 0, 0, false};
+    uint32_t first = end;
+    bool isFloat = false;
+
+    while (isHexDigit(source[end]))
+    {
+        appendSignificandDigit(&number, digitValue(source[end++]), 16, HEX_SIGNIFICAND_DIGITS, 4, false);
+    }
+
+    bool hasDigits = end > first;
+
+    if (source[end] == '.')
+    {
+        isFloat = true;
+        first = ++end;
 
-    default:
-        if (isDigit(c))
+        while (isHexDigit(source[end]))
         {
-            numberLiteral(tokenizer);
-            break;
+            appendSignificandDigit(&number, digitValue(source[end++]), 16, HEX_SIGNIFICAND_DIGITS, 4, true);
         }
-        else if (isAlpha(c) || peek(tokenizer) == '_')
+
+        hasDigits |= end > first;
+    }
+
+    tokenizer->length = end - tokenizer->start;
+
+    if (!hasDigits)
+    {
+        return false;
+    }
+
+    if (check(tokenizer, 'p') || check(tokenizer, 'P'))
+    {
+        if (!scanExponent(tokenizer, &number.exponent))
         {
-            identifier(tokenizer);
+            return false;
         }
+
+        isFloat = true;
+    }
+    else if (isFloat)
+    {
+        return false;
+    }
+
+    if (isFloat)
+    {
+        return floatLiteral(tokenizer, attribute, &number, true);
     }
 
-    return SCANNER_STATUS_OK;
+    return number.exponent == 0 && integerLiteral(tokenizer, attribute, number.significand, false);
 }
 
-ScannerStatus scanTokens(Tokenizer *tokenizer)
+static bool binaryNumberLiteral(Tokenizer *tokenizer, TokenAttribute *attribute)
 {
-    while (!isAtEnd(tokenizer))
+    const char *source = tokenizer->source;
+    uint32_t first = tokenizer->start + tokenizer->length;
+    uint32_t end = first;
+    uint64_t value = 0;
+    bool overflow = false;
+
+    while (source[end] == '0' || source[end] == '1')
     {
-        scanToken(tokenizer);
+        overflow |= (value >> 63) != 0;
+        value = (value << 1) | (uint64_t)(source[end++] - '0');
     }
 
-    addTokenWithLexeme(tokenizer, TOKEN_TYPE_EOF, "EOF");
-
-    return SCANNER_STATUS_OK;
+    tokenizer->length = end - tokenizer->start;
+    return end > first && !overflow && integerLiteral(tokenizer, attribute, value, false);
 }
 
-void appendTokenArray(TokenArray *array, Token token)
+static void addNumberToken(Tokenizer *tokenizer, TokenAttribute attribute)
 {
-    if (array->count >= array->capacity - 1)
-    {
-        growTokenArray(array);
-    }
+    Token token = {};
+    token.line = tokenizer->line;
+    token.type = attribute.type == TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL ? TOKEN_TYPE_FLOAT_LITERAL : TOKEN_TYPE_INT_LITERAL;
+    token.lexeme = NULL;
+    token.attribute = attribute;
+    appendTokenArray(&tokenizer->tokens, token);
 
-    array->tokens[array->count++] = token;
+    tokenizer->start += tokenizer->length;
+    tokenizer->length = 0;
 }
 
 void numberLiteral(Tokenizer *tokenizer)
 {
-    while (isDigit(peek(tokenizer)))
+    TokenAttribute attribute;
+    bool valid;
+
+    tokenizer->length = 0;
+
+    if (check(tokenizer, '0') && (peekNext(tokenizer) == 'x' || peekNext(tokenizer) == 'X'))
     {
         advance(tokenizer);
+        advance(tokenizer);
+        valid = hexNumberLiteral(tokenizer, &attribute);
+    }
+    else if (check(tokenizer, '0') && (peekNext(tokenizer) == 'b' || peekNext(tokenizer) == 'B'))
+    {
+        advance(tokenizer);
+        advance(tokenizer);
+        valid = binaryNumberLiteral(tokenizer, &attribute);
+    }
+    else
+    {
+        valid = decimalNumberLiteral(tokenizer, &attribute);
     }
 
-    bool isFloat = false;
-
-    char *lexeme = ALLOCATE(char, tokenizer->length + 1);
-    memcpy(lexeme, &tokenizer->source[tokenizer->start], tokenizer->length);
-    lexeme[tokenizer->length] = '\0';
+    const char *source = tokenizer->source;
+    uint32_t end = tokenizer->start + tokenizer->length;
 
-    if (!isFloat)
+    while (characterClasses[(uint8_t)source[end]] == CHARACTER_CLASS_IDENTIFIER ||
+           characterClasses[(uint8_t)source[end]] == CHARACTER_CLASS_DIGIT ||
+           characterClasses[(uint8_t)source[end]] == CHARACTER_CLASS_DOT)
     {
-        int literal = atoi(lexeme);
-        addTokenWithLiteral(tokenizer, TOKEN_TYPE_INT, lexeme, &literal, TOKEN_ATTRIBUTE_TYPE_INT_LITERAL);
+        valid = false;
+        end++;
     }
-    else
+
+    tokenizer->length = end - tokenizer->start;
+
+    if (!valid)
     {
-        float literal = atof(lexeme);
-        addTokenWithLiteral(tokenizer, TOKEN_TYPE_FLOAT, lexeme, &literal, TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL);
+        reportScannerError(tokenizer, SCANNER_STATUS_ERROR_INVALID_NUMBER, tokenizer->line);
+        attribute.type = TOKEN_ATTRIBUTE_TYPE_INT_LITERAL;
+        attribute.flags = TOKEN_LITERAL_FLAG_NONE;
+        attribute.value.integer = 0;
     }
+
+    addNumberToken(tokenizer, attribute);
 }
 
 void stringLiteral(Tokenizer *tokenizer)
 {
-    while (!check(tokenizer, '"'))
-    {
-        advance(tokenizer);
-    }
+    uint32_t position = tokenizer->start + tokenizer->length;
+    const char *quote = memchr(&tokenizer->source[position], '"', tokenizer->sourceLength - position);
 
-    if (isAtEnd(tokenizer))
+    if (quote == NULL)
     {
-        printf("Unterminated string at line %u.", tokenizer->line);
+        tokenizer->length = tokenizer->sourceLength - tokenizer->start;
+        reportScannerError(tokenizer, SCANNER_STATUS_ERROR_UNTERMINATED_STRING, tokenizer->line);
+        tokenizer->start += tokenizer->length;
+        tokenizer->length = 0;
+        return;
     }
 
-    advance(tokenizer);
+    tokenizer->length = (uint32_t)(quote - &tokenizer->source[tokenizer->start]) + 1;
 
     char *lexeme = ALLOCATE(char, tokenizer->length - 1);
     memcpy(lexeme, &tokenizer->source[tokenizer->start + 1], tokenizer->length - 2);
@@ -318,62 +956,28 @@ void stringLiteral(Tokenizer *tokenizer)
 
 void identifier(Tokenizer *tokenizer)
 {
-    while (isAlphanumeric(peek(tokenizer)) || peek(tokenizer) == '_')
+    const char *source = tokenizer->source;
+    uint32_t end = tokenizer->start + tokenizer->length;
+
+    while (characterClasses[(uint8_t)source[end]] == CHARACTER_CLASS_IDENTIFIER ||
+           characterClasses[(uint8_t)source[end]] == CHARACTER_CLASS_DIGIT)
     {
-        advance(tokenizer);
+        end++;
     }
 
-    char *lexeme = ALLOCATE(char, tokenizer->length + 1);
-    memcpy(lexeme, &tokenizer->source[tokenizer->start], tokenizer->length);
-    lexeme[tokenizer->length] = '\0';
-
-    static const struct
-    {
-        const char *keyword;
-        TokenType type;
-    } keywords[] = {
-        {"auto", TOKEN_TYPE_AUTO},
-        {"break", TOKEN_TYPE_BREAK},
-        {"case", TOKEN_TYPE_CASE},
-        {"char", TOKEN_TYPE_CHAR},
-        {"const", TOKEN_TYPE_CONST},
-        {"continue", TOKEN_TYPE_CONTINUE},
-        {"default", TOKEN_TYPE_DEFAULT},
-        {"do", TOKEN_TYPE_DO},
-        {"double", TOKEN_TYPE_DOUBLE},
-        {"else", TOKEN_TYPE_ELSE},
-        {"enum", TOKEN_TYPE_ENUM},
-        {"extern", TOKEN_TYPE_EXTERN},
-        {"float", TOKEN_TYPE_FLOAT},
-        {"for", TOKEN_TYPE_FOR},
-        {"goto", TOKEN_TYPE_GOTO},
-        {"if", TOKEN_TYPE_IF},
-        {"inline", TOKEN_TYPE_INLINE},
-        {"int", TOKEN_TYPE_INT},
-        {"long", TOKEN_TYPE_LONG},
-        {"register", TOKEN_TYPE_REGISTER},
-        {"return", TOKEN_TYPE_RETURN},
-        {"short", TOKEN_TYPE_SHORT},
-        {"signed", TOKEN_TYPE_SIGNED},
-        {"sizeof", TOKEN_TYPE_SIZEOF},
-        {"static", TOKEN_TYPE_STATIC},
-        {"struct", TOKEN_TYPE_STRUCT},
-        {"switch", TOKEN_TYPE_SWITCH},
-        {"typedef", TOKEN_TYPE_TYPEDEF},
-        {"union", TOKEN_TYPE_UNION},
-        {"unsigned", TOKEN_TYPE_UNSIGNED},
-        {"void", TOKEN_TYPE_VOID},
-        {"volatile", TOKEN_TYPE_VOLATILE},
-        {"while", TOKEN_TYPE_WHILE},
-    };
+    tokenizer->length = end - tokenizer->start;
 
+    const char *lexeme = &source[tokenizer->start];
+    uint32_t length = tokenizer->length;
     TokenType type = TOKEN_TYPE_IDENTIFIER;
-    for (size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++)
+
+    if (length <= KEYWORD_MAX_LENGTH)
     {
-        if (strcmp(lexeme, keywords[i].keyword) == 0)
+        uint32_t slot = KEYWORD_SLOT((uint8_t)lexeme[0], (uint8_t)lexeme[length - 1], length);
+
+        if (keywords[slot].length == length && memcmp(lexeme, keywords[slot].keyword, length) == 0)
         {
-            type = keywords[i].type;
-            break;
+            type = keywords[slot].type;
         }
     }
 
@@ -410,6 +1014,11 @@ bool isDigit(char c)
     return c >= '0' && c <= '9';
 }
 
+bool isHexDigit(char c)
+{
+    return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
 bool isAlpha(char c)
 {
     return c >= 'a' && c <= 'z' || c >= 'A' && c <= 'Z';
@@ -492,17 +1101,16 @@ void addTokenWithLiteral(Tokenizer *tokenizer, TokenType type, char *lexeme, voi
     switch (attributeType)
     {
     case TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL:
-        token.attribute.value.floating = *(float *)attribute;
+        token.attribute.value.floating = *(double *)attribute;
         break;
 
     case TOKEN_ATTRIBUTE_TYPE_INT_LITERAL:
-        token.attribute.value.integer = *(int *)attribute;
+        token.attribute.value.integer = *(uint64_t *)attribute;
         break;
 
     case TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL:
         token.attribute.value.string = (char *)attribute;
         break;
-        break;
 
     case TOKEN_ATTRIBUTE_TYPE_NULL_ATTRIBUTE:
         token.attribute.value.integer = 0;
@@ -0,0 +1,15 @@
+#ifndef NUMBER_H
+#define NUMBER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DECIMAL_SIGNIFICAND_DIGITS 19
+#define HEX_SIGNIFICAND_DIGITS 16
+
+bool decimalToDouble(uint64_t significand, int64_t exponent, bool truncated, double *value);
+bool hexToDouble(uint64_t significand, int64_t exponent, bool truncated, double *value);
+bool decimalToFloat(uint64_t significand, int64_t exponent, bool truncated, float *value);
+bool hexToFloat(uint64_t significand, int64_t exponent, bool truncated, float *value);
+
+#endif
@@ -7,6 +7,9 @@
 typedef enum
 {
     SCANNER_STATUS_ERROR_INVALID_CHARACTER,
+    SCANNER_STATUS_ERROR_UNTERMINATED_STRING,
+    SCANNER_STATUS_ERROR_INVALID_NUMBER,
+    SCANNER_STATUS_ERROR_UNTERMINATED_COMMENT,
     SCANNER_STATUS_OK,
 } ScannerStatus;
 
@@ -87,6 +90,8 @@ typedef enum
     TOKEN_TYPE_VOLATILE,
     TOKEN_TYPE_WHILE,
     TOKEN_TYPE_STRING_LITERAL,
+    TOKEN_TYPE_INT_LITERAL,
+    TOKEN_TYPE_FLOAT_LITERAL,
     TOKEN_TYPE_IDENTIFIER,
     TOKEN_TYPE_INLINE,
 } TokenType;
@@ -99,14 +104,25 @@ typedef enum
     TOKEN_ATTRIBUTE_TYPE_STRING_LITERAL,
 } TokenAttributeType;
 
+typedef enum
+{
+    TOKEN_LITERAL_FLAG_NONE = 0,
+    TOKEN_LITERAL_FLAG_UNSIGNED = 1 << 0,
+    TOKEN_LITERAL_FLAG_LONG = 1 << 1,
+    TOKEN_LITERAL_FLAG_LONG_LONG = 1 << 2,
+    TOKEN_LITERAL_FLAG_FLOAT = 1 << 3,
+    TOKEN_LITERAL_FLAG_NON_DECIMAL = 1 << 4,
+} TokenLiteralFlag;
+
 typedef struct
 {
     TokenAttributeType type;
+    uint8_t flags;
     union
     {
         bool boolean;
-        int integer;
-        float floating;
+        uint64_t integer;
+        double floating;
         char *string;
     } value;
 } TokenAttribute;
@@ -2,15 +2,13 @@
 #define TOKENIZER_H
 
 #include <token.h>
+#include <array.h>
 #include <stdint.h>
 #include <stdbool.h>
 
-typedef struct
-{
-    size_t count;
-    size_t capacity;
-    Token *tokens;
-} TokenArray;
+#define PARALLEL_SCAN_MIN_CHUNK_SIZE (1 << 20)
+
+DECLARE_ARRAY(TokenArray, Token, tokens);
 
 typedef struct
 {
@@ -18,15 +16,20 @@ typedef struct
     uint32_t start;
     uint32_t length;
     uint32_t sourceLength;
+    uint32_t threadCount;
+    ScannerStatus status;
+    uint32_t errorLine;
     TokenArray tokens;
     const char *source;
 } Tokenizer;
 
 void initTokenizer(Tokenizer *tokenizer);
+void resetTokenizer(Tokenizer *tokenizer);
+void freeTokenizer(Tokenizer *tokenizer);
 void setTokenizerSourceCode(Tokenizer *tokenizer, const char *source);
 ScannerStatus scanToken(Tokenizer *tokenizer);
 ScannerStatus scanTokens(Tokenizer *tokenizer);
-void appendTokenArray(TokenArray *array, Token token);
+ScannerStatus scanTokensParallel(Tokenizer *tokenizer);
 
 void numberLiteral(Tokenizer *tokenizer);
 void stringLiteral(Tokenizer *tokenizer);
@@ -36,6 +39,7 @@ char advance(Tokenizer *tokenizer);
 char peek(Tokenizer *tokenizer);
 char peekNext(Tokenizer *tokenizer);
 bool isDigit(char c);
+bool isHexDigit(char c);
 bool isAlpha(char c);
 bool isAlphanumeric(char c);
 bool match(Tokenizer *tokenizer, char c);
@@ -0,0 +1,193 @@
+#include <types.h>
+#include <memory.h>
+#include <array.h>
+#include <string.h>
+
+static const Type builtinTypes[TYPE_ID_BUILTIN_COUNT] = {
+    {TYPE_KIND_INVALID, 0, 0, false, TYPE_ID_INVALID},
+    {TYPE_KIND_VOID, 0, 0, false, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 1, 1, false, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 1, 1, false, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 1, 1, true, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 2, 2, false, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 2, 2, true, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 4, 3, false, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 4, 3, true, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 4, 4, false, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 4, 4, true, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 8, 5, false, TYPE_ID_INVALID},
+    {TYPE_KIND_INTEGER, 8, 5, true, TYPE_ID_INVALID},
+    {TYPE_KIND_FLOATING, 4, 1, false, TYPE_ID_INVALID},
+    {TYPE_KIND_FLOATING, 8, 2, false, TYPE_ID_INVALID},
+    {TYPE_KIND_FLOATING, 12, 3, false, TYPE_ID_INVALID},
+};
+
+typedef struct
+{
+    Type type;
+    TypeId id;
+} TypeSlot;
+
+static uint64_t hashType(const Type *type)
+{
+    uint64_t hash = ((uint64_t)type->kind << 56) ^ ((uint64_t)type->size << 48) ^ ((uint64_t)type->rank << 40) ^
+                    ((uint64_t)type->isUnsigned << 32) ^ type->base;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static uint64_t hashTypeSlot(const void *slot)
+{
+    return hashType(&((const TypeSlot *)slot)->type);
+}
+
+static bool typeEquals(const Type *a, const Type *b)
+{
+    return a->kind == b->kind && a->size == b->size && a->rank == b->rank && a->isUnsigned == b->isUnsigned &&
+           a->base == b->base;
+}
+
+static TypeId findType(const TypeTable *table, const Type *type, uint64_t hash)
+{
+    HashMapProbe probe;
+    TypeSlot *slot;
+
+    startHashMapProbe(&table->slots, hash, &probe);
+
+    while ((slot = nextHashMapMatch(&table->slots, &probe)) != NULL)
+    {
+        if (typeEquals(&slot->type, type))
+        {
+            return slot->id;
+        }
+    }
+
+    return TYPE_ID_INVALID;
+}
+
+static void addTypeSlot(TypeTable *table, const Type *type, uint64_t hash, TypeId id)
+{
+    TypeSlot *slot = insertHashMap(&table->slots, hash);
+    slot->type = *type;
+    slot->id = id;
+}
+
+void initTypeTable(TypeTable *table)
+{
+    table->count = TYPE_ID_BUILTIN_COUNT;
+    table->capacity = MIN_ARRAY_SIZE > TYPE_ID_BUILTIN_COUNT ? MIN_ARRAY_SIZE : TYPE_ID_BUILTIN_COUNT;
+    table->types = ALLOCATE(Type, table->capacity);
+    memcpy(table->types, builtinTypes, sizeof(builtinTypes));
+    initHashMap(&table->slots, sizeof(TypeSlot), TYPE_TABLE_MIN_SLOTS, hashTypeSlot);
+
+    for (TypeId id = TYPE_ID_VOID; id < TYPE_ID_BUILTIN_COUNT; id++)
+    {
+        uint64_t hash = hashType(&builtinTypes[id]);
+
+        if (findType(table, &builtinTypes[id], hash) == TYPE_ID_INVALID)
+        {
+            addTypeSlot(table, &builtinTypes[id], hash, id);
+        }
+    }
+}
+
+void freeTypeTable(TypeTable *table)
+{
+    FREE(table->types);
+    freeHashMap(&table->slots);
+    table->types = NULL;
+    table->count = 0;
+    table->capacity = 0;
+}
+
+TypeId internType(TypeTable *table, Type type)
+{
+    uint64_t hash = hashType(&type);
+    TypeId existing = findType(table, &type, hash);
+
+    if (existing != TYPE_ID_INVALID)
+    {
+        return existing;
+    }
+
+    if (table->count >= table->capacity)
+    {
+        size_t oldCapacity = table->capacity;
+        table->capacity = oldCapacity * ARRAY_GROW_FACTOR;
+        table->types = REALLOCATE(Type, table->types, oldCapacity, table->capacity);
+    }
+
+    TypeId id = (TypeId)table->count++;
+    table->types[id] = type;
+    addTypeSlot(table, &type, hash, id);
+
+    return id;
+}
+
+TypeId internPointerType(TypeTable *table, TypeId base)
+{
+    Type pointer = {TYPE_KIND_POINTER, TYPE_POINTER_SIZE, 0, true, base};
+    return internType(table, pointer);
+}
+
+const Type *getType(const TypeTable *table, TypeId id)
+{
+    return &table->types[id < table->count ? id : TYPE_ID_INVALID];
+}
+
+uint32_t getTypeSize(const TypeTable *table, TypeId id)
+{
+    return getType(table, id)->size;
+}
+
+bool isIntegerType(const TypeTable *table, TypeId id)
+{
+    return getType(table, id)->kind == TYPE_KIND_INTEGER;
+}
+
+bool isFloatingType(const TypeTable *table, TypeId id)
+{
+    return getType(table, id)->kind == TYPE_KIND_FLOATING;
+}
+
+bool isArithmeticType(const TypeTable *table, TypeId id)
+{
+    return isIntegerType(table, id) || isFloatingType(table, id);
+}
+
+bool isScalarType(const TypeTable *table, TypeId id)
+{
+    return isArithmeticType(table, id) || getType(table, id)->kind == TYPE_KIND_POINTER;
+}
+
+TypeId promoteType(const TypeTable *table, TypeId id)
+{
+    const Type *type = getType(table, id);
+
+    if (type->kind == TYPE_KIND_INTEGER && type->rank < builtinTypes[TYPE_ID_INT].rank)
+    {
+        return TYPE_ID_INT;
+    }
+
+    return id;
+}
+
+uint64_t truncateIntegerValue(const TypeTable *table, TypeId id, uint64_t value)
+{
+    uint32_t size = getTypeSize(table, id);
+    return size >= 8 ? value : value & (((uint64_t)1 << (size * 8)) - 1);
+}
+
+uint64_t convertIntegerValue(const TypeTable *table, TypeId from, TypeId to, uint64_t value)
+{
+    const Type *type = getType(table, from);
+
+    if (!type->isUnsigned && type->size < 8 && (value & ((uint64_t)1 << (type->size * 8 - 1))) != 0)
+    {
+        value |= ~(((uint64_t)1 << (type->size * 8)) - 1);
+    }
+
+    return truncateIntegerValue(table, to, value);
+}
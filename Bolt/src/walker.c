@@ -0,0 +1,186 @@
+#include <walker.h>
+#include <memory.h>
+#include <string.h>
+
+static void growAstWalker(AstWalker *walker)
+{
+    size_t oldCapacity = walker->capacity;
+    size_t newCapacity = oldCapacity * ARRAY_GROW_FACTOR;
+
+    if (walker->frames == walker->inlineFrames)
+    {
+        walker->frames = ALLOCATE(AstWalkFrame, newCapacity);
+        memcpy(walker->frames, walker->inlineFrames, oldCapacity * sizeof(AstWalkFrame));
+    }
+    else
+    {
+        walker->frames = REALLOCATE(AstWalkFrame, walker->frames, oldCapacity, newCapacity);
+    }
+
+    walker->capacity = newCapacity;
+}
+
+static bool enterAst(AstWalker *walker, Ast *ast, const AstVisitor *visitor, void *context)
+{
+    AstWalkAction action = visitor->pre != NULL ? visitor->pre(ast, context) : AST_WALK_CONTINUE;
+
+    if (action == AST_WALK_STOP)
+    {
+        return false;
+    }
+
+    if (walker->count >= walker->capacity)
+    {
+        growAstWalker(walker);
+    }
+
+    AstWalkFrame *frame = &walker->frames[walker->count++];
+    frame->ast = ast;
+    frame->nextChild = 0;
+    frame->descend = action == AST_WALK_CONTINUE;
+
+    return true;
+}
+
+void initAstWalker(AstWalker *walker)
+{
+    walker->count = 0;
+    walker->capacity = AST_WALKER_INLINE_FRAMES;
+    walker->frames = walker->inlineFrames;
+}
+
+void freeAstWalker(AstWalker *walker)
+{
+    if (walker->frames != walker->inlineFrames)
+    {
+        FREE(walker->frames);
+    }
+
+    initAstWalker(walker);
+}
+
+bool walkAst(AstWalker *walker, Ast *root, const AstVisitor *visitor, void *context)
+{
+    walker->count = 0;
+
+    if (!enterAst(walker, root, visitor, context))
+    {
+        return false;
+    }
+
+    while (walker->count > 0)
+    {
+        AstWalkFrame *frame = &walker->frames[walker->count - 1];
+        size_t childCount = frame->descend ? getAstChildCount(frame->ast) : 0;
+        Ast *child = NULL;
+
+        while (child == NULL && frame->nextChild < childCount)
+        {
+            child = getAstChild(frame->ast, frame->nextChild++);
+        }
+
+        if (child != NULL)
+        {
+            if (!enterAst(walker, child, visitor, context))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        Ast *ast = frame->ast;
+        walker->count--;
+
+        if (visitor->post != NULL && visitor->post(ast, context) == AST_WALK_STOP)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t getAstChildCount(Ast *ast)
+{
+    switch (ast->type)
+    {
+    case AST_TYPE_UNARY_EXPRESSION_NODE:
+    case AST_TYPE_CALL_EXPRESSION_NODE:
+        return 1;
+
+    case AST_TYPE_BINARY_EXPRESSION_NODE:
+    case AST_TYPE_ASSIGNMENT_EXPRESSION_NODE:
+    case AST_TYPE_CAST_EXPRESSION_NODE:
+        return 2;
+
+    case AST_TYPE_TERNARY_EXPRESSION_NODE:
+        return 3;
+
+    case AST_TYPE_FUNCTION_DECLARATION_NODE:
+        return ((AstFunctionDeclaration *)ast)->bodyCount;
+
+    case AST_TYPE_SWITCH_STATEMENT_NODE:
+        return 1 + (size_t)((AstSwitchStatement *)ast)->bodyCount;
+
+    case AST_TYPE_CASE_LABEL_NODE:
+        return ((AstCaseLabel *)ast)->value != NULL ? 1 : 0;
+
+    default:
+        return 0;
+    }
+}
+
+Ast *getAstChild(Ast *ast, size_t index)
+{
+    switch (ast->type)
+    {
+    case AST_TYPE_UNARY_EXPRESSION_NODE:
+        return index == 0 ? ((AstUnaryExpression *)ast)->right : NULL;
+
+    case AST_TYPE_BINARY_EXPRESSION_NODE:
+    {
+        AstBinaryExpression *binary = (AstBinaryExpression *)ast;
+        return index == 0 ? binary->left : index == 1 ? binary->right : NULL;
+    }
+
+    case AST_TYPE_TERNARY_EXPRESSION_NODE:
+    {
+        AstTernaryExpression *ternary = (AstTernaryExpression *)ast;
+        return index == 0 ? ternary->condition : index == 1 ? ternary->thenBranch : index == 2 ? ternary->elseBranch : NULL;
+    }
+
+    case AST_TYPE_ASSIGNMENT_EXPRESSION_NODE:
+    {
+        AstAssignmentExpression *assignment = (AstAssignmentExpression *)ast;
+        return index == 0 ? assignment->target : index == 1 ? assignment->value : NULL;
+    }
+
+    case AST_TYPE_CALL_EXPRESSION_NODE:
+        return index == 0 ? ((AstCallExpression *)ast)->callee : NULL;
+
+    case AST_TYPE_CAST_EXPRESSION_NODE:
+    {
+        AstCastExpression *cast = (AstCastExpression *)ast;
+        return index == 0 ? cast->type : index == 1 ? cast->target : NULL;
+    }
+
+    case AST_TYPE_FUNCTION_DECLARATION_NODE:
+    {
+        AstFunctionDeclaration *function = (AstFunctionDeclaration *)ast;
+        return index < function->bodyCount ? function->body[index] : NULL;
+    }
+
+    case AST_TYPE_SWITCH_STATEMENT_NODE:
+    {
+        AstSwitchStatement *statement = (AstSwitchStatement *)ast;
+        return index == 0 ? statement->selector : index <= statement->bodyCount ? statement->body[index - 1] : NULL;
+    }
+
+    case AST_TYPE_CASE_LABEL_NODE:
+        return index == 0 ? ((AstCaseLabel *)ast)->value : NULL;
+
+    default:
+        return NULL;
+    }
+}
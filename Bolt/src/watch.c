@@ -0,0 +1,199 @@
+#include <watch.h>
+#include <memory.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+typedef struct
+{
+    Compiler *compiler;
+    const char *inputPath;
+    const char *outputPath;
+    char *temporaryPath;
+    uint64_t sourceHash;
+    bool compiled;
+} WatchState;
+
+static uint64_t hashWatchSource(const char *source)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    while (*source != '\0')
+    {
+        hash ^= (uint8_t)*source++;
+        hash *= 0x100000001B3ull;
+    }
+
+    return hash;
+}
+
+static double getWatchMilliseconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec * 1000.0 + (double)now.tv_nsec / 1000000.0;
+}
+
+static bool writeWatchOutput(WatchState *state)
+{
+    AssemblyBuffer *assembly = &state->compiler->assembler.output;
+    FILE *output = fopen(state->temporaryPath, "w");
+
+    if (output == NULL)
+    {
+        return false;
+    }
+
+    size_t written = fwrite(assembly->data, sizeof(char), assembly->count, output);
+    bool ok = fflush(output) == 0 && fsync(fileno(output)) == 0 && written == assembly->count;
+
+    if (fclose(output) != 0 || !ok || rename(state->temporaryPath, state->outputPath) != 0)
+    {
+        remove(state->temporaryPath);
+        return false;
+    }
+
+    return true;
+}
+
+static void recompileWatchedFile(WatchState *state)
+{
+    Compiler *compiler = state->compiler;
+    double start = getWatchMilliseconds();
+
+    if (!setCompilerRoot(compiler, state->inputPath))
+    {
+        fprintf(stderr, "%s\n", compiler->error);
+        return;
+    }
+
+    uint64_t sourceHash = hashWatchSource(compiler->source);
+
+    if (state->compiled && sourceHash == state->sourceHash)
+    {
+        return;
+    }
+
+    resetCompiler(compiler);
+
+    if (!setCompilerRoot(compiler, state->inputPath))
+    {
+        fprintf(stderr, "%s\n", compiler->error);
+        return;
+    }
+
+    state->sourceHash = hashWatchSource(compiler->source);
+    state->compiled = true;
+
+    if (compileCode(compiler) != COMPILER_STATUS_OK)
+    {
+        fprintf(stderr, "%s\n", compiler->error);
+        return;
+    }
+
+    if (!writeWatchOutput(state))
+    {
+        fprintf(stderr, "Error: Could not write output file '%s'.\n", state->outputPath);
+        return;
+    }
+
+    fprintf(stderr, "Compiled '%s' in %.2f ms.\n", state->inputPath, getWatchMilliseconds() - start);
+}
+
+static bool isWatchedEvent(const struct inotify_event *event, const char *fileName)
+{
+    return event->len > 0 && strcmp(event->name, fileName) == 0 &&
+           (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0;
+}
+
+bool runWatchMode(Compiler *compiler, const char *inputPath, const char *outputPath)
+{
+    const char *separator = strrchr(inputPath, '/');
+    const char *fileName = separator != NULL ? separator + 1 : inputPath;
+    size_t directoryLength = separator != NULL && separator != inputPath ? (size_t)(separator - inputPath) : 1;
+    char *directory = ALLOCATE(char, directoryLength + 1);
+    memcpy(directory, separator != NULL ? inputPath : ".", directoryLength);
+    directory[directoryLength] = '\0';
+
+    int watcher = inotify_init1(IN_CLOEXEC);
+
+    if (watcher < 0 || inotify_add_watch(watcher, directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        fprintf(stderr, "Error: Could not watch directory '%s'.\n", directory);
+
+        if (watcher >= 0)
+        {
+            close(watcher);
+        }
+
+        FREE(directory);
+        return false;
+    }
+
+    FREE(directory);
+
+    WatchState state;
+    state.compiler = compiler;
+    state.inputPath = inputPath;
+    state.outputPath = outputPath;
+    state.temporaryPath = ALLOCATE(char, strlen(outputPath) + 5);
+    sprintf(state.temporaryPath, "%s.tmp", outputPath);
+    state.sourceHash = 0;
+    state.compiled = false;
+
+    recompileWatchedFile(&state);
+
+    _Alignas(struct inotify_event) char buffer[WATCH_EVENT_BUFFER_SIZE];
+
+    for (;;)
+    {
+        ssize_t length = read(watcher, buffer, sizeof(buffer));
+
+        if (length < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (length <= 0)
+        {
+            break;
+        }
+
+        bool changed = false;
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const struct inotify_event *event = (const struct inotify_event *)&buffer[offset];
+            changed = changed || isWatchedEvent(event, fileName);
+            offset += (ssize_t)(sizeof(struct inotify_event) + event->len);
+        }
+
+        if (changed)
+        {
+            recompileWatchedFile(&state);
+        }
+    }
+
+    close(watcher);
+    FREE(state.temporaryPath);
+    return false;
+}
+
+#else
+
+bool runWatchMode(Compiler *compiler, const char *inputPath, const char *outputPath)
+{
+    (void)compiler;
+    (void)inputPath;
+    (void)outputPath;
+    fprintf(stderr, "Error: Watch mode is not supported on this platform.\n");
+    return false;
+}
+
+#endif
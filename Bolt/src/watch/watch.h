@@ -0,0 +1,10 @@
+#ifndef WATCH_H
+#define WATCH_H
+
+#include <compiler.h>
+
+#define WATCH_EVENT_BUFFER_SIZE 4096
+
+bool runWatchMode(Compiler *compiler, const char *inputPath, const char *outputPath);
+
+#endif
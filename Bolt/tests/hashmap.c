@@ -0,0 +1,127 @@
+#include <hashmap.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HASH_MAP_TEST_COUNT 20000
+#define HASH_MAP_TEST_BUCKETS 7
+
+typedef struct
+{
+    uint64_t key;
+    uint64_t value;
+} HashMapEntry;
+
+static int failures = 0;
+
+static uint64_t mixKey(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    return key;
+}
+
+static uint64_t hashEntry(const void *slot)
+{
+    return mixKey(((const HashMapEntry *)slot)->key);
+}
+
+static uint64_t hashEntryBucket(const void *slot)
+{
+    return mixKey(((const HashMapEntry *)slot)->key % HASH_MAP_TEST_BUCKETS);
+}
+
+static HashMapEntry *findEntry(const HashMap *map, uint64_t key)
+{
+    HashMapEntry probeEntry = {key, 0};
+    HashMapProbe probe;
+    HashMapEntry *entry;
+
+    startHashMapProbe(map, map->hash(&probeEntry), &probe);
+
+    while ((entry = nextHashMapMatch(map, &probe)) != NULL)
+    {
+        if (entry->key == key)
+        {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static void insertEntry(HashMap *map, uint64_t key, uint64_t value)
+{
+    HashMapEntry entry = {key, value};
+    *(HashMapEntry *)insertHashMap(map, map->hash(&entry)) = entry;
+}
+
+static void check(bool condition, const char *message, uint64_t key)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "%s (key %llu)\n", message, (unsigned long long)key);
+        failures++;
+    }
+}
+
+static void testInsertGrowLookup(HashMapHashFunction hash, uint64_t count)
+{
+    HashMap map;
+    initHashMap(&map, sizeof(HashMapEntry), 0, hash);
+    size_t initialCapacity = map.capacity;
+
+    for (uint64_t key = 0; key < count; key++)
+    {
+        insertEntry(&map, key * 3, key);
+    }
+
+    check(map.count == count, "count does not match inserted entries", count);
+    check(map.capacity > initialCapacity, "map did not grow", map.capacity);
+    check(map.count * HASH_MAP_MAX_LOAD_DENOMINATOR <= map.capacity * HASH_MAP_MAX_LOAD_NUMERATOR,
+          "map exceeds its load factor", map.capacity);
+
+    for (uint64_t key = 0; key < count; key++)
+    {
+        HashMapEntry *entry = findEntry(&map, key * 3);
+        check(entry != NULL && entry->value == key, "inserted key not found", key * 3);
+        check(findEntry(&map, key * 3 + 1) == NULL, "missing key found", key * 3 + 1);
+    }
+
+    resetHashMap(&map);
+    check(map.count == 0, "reset left entries behind", map.count);
+    check(findEntry(&map, 0) == NULL, "reset map still finds a key", 0);
+
+    freeHashMap(&map);
+}
+
+static void testReserve(void)
+{
+    HashMap map;
+    initHashMap(&map, sizeof(HashMapEntry), 0, hashEntry);
+    reserveHashMap(&map, HASH_MAP_TEST_COUNT);
+    size_t capacity = map.capacity;
+
+    for (uint64_t key = 0; key < HASH_MAP_TEST_COUNT; key++)
+    {
+        insertEntry(&map, key, key);
+    }
+
+    check(map.capacity == capacity, "reserved map grew during insertion", map.capacity);
+    freeHashMap(&map);
+}
+
+int main(void)
+{
+    testInsertGrowLookup(hashEntry, HASH_MAP_TEST_COUNT);
+    testInsertGrowLookup(hashEntryBucket, 2000);
+    testReserve();
+
+    if (failures > 0)
+    {
+        fprintf(stderr, "%d hash map checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,69 @@
+function(find_native_toolchain workDir reason)
+    set(${reason} "" PARENT_SCOPE)
+
+    if(NOT NASM OR NASM MATCHES "NOTFOUND$")
+        set(${reason} "nasm not found" PARENT_SCOPE)
+        return()
+    endif()
+
+    file(MAKE_DIRECTORY "${workDir}")
+    file(WRITE "${workDir}/probe.s" "section .text\n\tglobal main\nmain:\n\txor eax, eax\n\tret\n")
+    execute_process(COMMAND "${NASM}" -f elf32 "${workDir}/probe.s" -o "${workDir}/probe.o"
+                    RESULT_VARIABLE result OUTPUT_QUIET ERROR_QUIET)
+
+    if(result EQUAL 0)
+        execute_process(COMMAND "${CC}" -m32 -no-pie "${workDir}/probe.o" -o "${workDir}/probe"
+                        RESULT_VARIABLE result OUTPUT_QUIET ERROR_QUIET)
+    endif()
+
+    if(NOT result EQUAL 0)
+        set(${reason} "cannot link 32-bit programs with ${CC}" PARENT_SCOPE)
+    endif()
+endfunction()
+
+function(link_native assembly executable)
+    execute_process(COMMAND "${NASM}" -f elf32 "${assembly}" -o "${assembly}.o"
+                    RESULT_VARIABLE result OUTPUT_QUIET ERROR_VARIABLE error)
+
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "nasm failed on ${assembly}: ${error}")
+    endif()
+
+    execute_process(COMMAND "${CC}" -m32 -no-pie "${assembly}.o" -o "${executable}"
+                    RESULT_VARIABLE result OUTPUT_QUIET ERROR_VARIABLE error)
+
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Linking ${executable} failed: ${error}")
+    endif()
+endfunction()
+
+# Emitted programs return whatever is left in eax, so only a signal counts as a failed run.
+function(run_native executable workDir)
+    execute_process(COMMAND "${executable}" WORKING_DIRECTORY "${workDir}"
+                    RESULT_VARIABLE result OUTPUT_QUIET ERROR_QUIET)
+
+    if(NOT result MATCHES "^[0-9]+$")
+        message(FATAL_ERROR "${executable} did not exit normally: ${result}")
+    endif()
+endfunction()
+
+function(compile_boltc source assembly)
+    execute_process(COMMAND "${BOLTC}" ${ARGN} "${source}" -o "${assembly}"
+                    RESULT_VARIABLE result OUTPUT_QUIET ERROR_VARIABLE error)
+
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "BoltC failed on ${source} with '${ARGN}': ${error}")
+    endif()
+endfunction()
+
+function(time_native executable workDir runs microseconds)
+    string(TIMESTAMP start "%s%f")
+
+    foreach(run RANGE 1 ${runs})
+        run_native("${executable}" "${workDir}")
+    endforeach()
+
+    string(TIMESTAMP end "%s%f")
+    math(EXPR elapsed "(${end} - ${start}) / ${runs}")
+    set(${microseconds} ${elapsed} PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,186 @@
+#include <tokenizer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RANDOM_LITERAL_COUNT 20000
+#define RANDOM_LITERAL_SIZE 64
+
+static const char *floatLiterals[] = {
+    "0.0", "1.0", "1.5", "0.1", "0.2", "0.3", "2.25", "1e23", "1e22", "9007199254740993.0",
+    "123456789012345678901234567890e-10", "2.2250738585072011e-308", "2.2250738585072014e-308", "4.9e-324",
+    "2.4703282292062327e-324", "1.7976931348623157e308", "1.7976931348623159e308", "1e-400", "1e400",
+    "0.000000000000000000000000000000000000000000001", "7.038531e-26", "1.00000005960464477550",
+    "0x1.8p1", "0x1p-1074", "0x1.fffffffffffffp1023", "0x.8p0", "0x10.4p-3", "1.5L", "1e5", "3.",
+    "0.1f", "0.2f", "1.5f", "2.25f", "16777217.0f", "16777219.0f", "3.4028235e38f", "3.4028236e38f",
+    "3.40282357e38f", "1e39f", "1.17549435e-38f", "1.17549421e-38f", "1e-45f", "1.4e-45f", "7e-46f",
+    "1e-46f", "7.038531e-26f", "1.00000005960464477550f", "1.0000000596046448f", "1.00000017881393432617187499f",
+    "8.589973e9f", "4.7223665e21f", "1234567890123456789012345678901234567890.0f", "0x1.fffffep127f", "0x1p-149f",
+    "0x1.000001p0f", "0x1.0000011p0f", "1e10f", "1e-10f", "123e-12f",
+};
+
+static const struct
+{
+    const char *text;
+    unsigned long long value;
+} integerLiterals[] = {
+    {"0", 0},
+    {"42", 42},
+    {"18446744073709551615", 18446744073709551615ull},
+    {"0x7FFFFFFF", 0x7FFFFFFF},
+    {"0xffffffffffffffff", 0xFFFFFFFFFFFFFFFFull},
+    {"0777", 0777},
+    {"0b101010", 42},
+    {"4294967295u", 4294967295u},
+    {"9223372036854775807ll", 9223372036854775807ll},
+};
+
+static const char *invalidLiterals[] = {
+    "18446744073709551616", "0x", "0b", "0b102", "089", "1.5q", "0x1.8", "1e", "0x10000000000000000",
+};
+
+static int failures = 0;
+
+static bool scanLiteral(const char *source, TokenAttribute *attribute)
+{
+    Tokenizer tokenizer;
+    initTokenizer(&tokenizer);
+    setTokenizerSourceCode(&tokenizer, source);
+
+    bool scanned = scanTokens(&tokenizer) == SCANNER_STATUS_OK && tokenizer.tokens.count > 0;
+
+    if (scanned)
+    {
+        *attribute = tokenizer.tokens.tokens[0].attribute;
+    }
+
+    freeTokenizer(&tokenizer);
+    return scanned;
+}
+
+static void checkFloatLiteral(const char *text)
+{
+    TokenAttribute attribute;
+    size_t length = strlen(text);
+    bool single = text[length - 1] == 'f' || text[length - 1] == 'F';
+
+    if (!scanLiteral(text, &attribute) || attribute.type != TOKEN_ATTRIBUTE_TYPE_FLOAT_LITERAL)
+    {
+        fprintf(stderr, "%s: not scanned as a float literal\n", text);
+        failures++;
+        return;
+    }
+
+    if (single)
+    {
+        float expected = strtof(text, NULL);
+        float actual = (float)attribute.value.floating;
+
+        if (memcmp(&expected, &actual, sizeof(float)) != 0 || attribute.value.floating != actual)
+        {
+            fprintf(stderr, "%s: expected %a, got %a\n", text, expected, attribute.value.floating);
+            failures++;
+        }
+
+        return;
+    }
+
+    double expected = strtod(text, NULL);
+
+    if (memcmp(&expected, &attribute.value.floating, sizeof(double)) != 0)
+    {
+        fprintf(stderr, "%s: expected %a, got %a\n", text, expected, attribute.value.floating);
+        failures++;
+    }
+}
+
+static void checkIntegerLiteral(const char *text, unsigned long long value)
+{
+    TokenAttribute attribute;
+
+    if (!scanLiteral(text, &attribute) || attribute.type != TOKEN_ATTRIBUTE_TYPE_INT_LITERAL ||
+        attribute.value.integer != value)
+    {
+        fprintf(stderr, "%s: expected integer %llu\n", text, value);
+        failures++;
+    }
+}
+
+static void checkInvalidLiteral(const char *text)
+{
+    TokenAttribute attribute;
+
+    if (scanLiteral(text, &attribute))
+    {
+        fprintf(stderr, "%s: expected a scanner error\n", text);
+        failures++;
+    }
+}
+
+static uint64_t nextRandom(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ull + 1442695040888963407ull;
+    return *state >> 33;
+}
+
+static void generateFloatLiteral(uint64_t *state, char *text, bool single)
+{
+    size_t length = 0;
+    uint64_t digits = 1 + nextRandom(state) % 30;
+    uint64_t point = nextRandom(state) % (digits + 1);
+
+    for (uint64_t i = 0; i < digits; i++)
+    {
+        if (i == point)
+        {
+            text[length++] = '.';
+        }
+
+        text[length++] = (char)('0' + nextRandom(state) % 10);
+    }
+
+    if (point == digits)
+    {
+        text[length++] = '.';
+    }
+
+    int range = single ? 100 : 700;
+    int exponent = (int)(nextRandom(state) % (uint64_t)range) - range / 2;
+    length += (size_t)snprintf(text + length, RANDOM_LITERAL_SIZE - length, "e%d%s", exponent, single ? "f" : "");
+    text[length] = '\0';
+}
+
+int main(void)
+{
+    char text[RANDOM_LITERAL_SIZE];
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+
+    for (size_t i = 0; i < sizeof(floatLiterals) / sizeof(floatLiterals[0]); i++)
+    {
+        checkFloatLiteral(floatLiterals[i]);
+    }
+
+    for (size_t i = 0; i < sizeof(integerLiterals) / sizeof(integerLiterals[0]); i++)
+    {
+        checkIntegerLiteral(integerLiterals[i].text, integerLiterals[i].value);
+    }
+
+    for (size_t i = 0; i < sizeof(invalidLiterals) / sizeof(invalidLiterals[0]); i++)
+    {
+        checkInvalidLiteral(invalidLiterals[i]);
+    }
+
+    for (int i = 0; i < RANDOM_LITERAL_COUNT; i++)
+    {
+        generateFloatLiteral(&state, text, i % 2 == 0);
+        checkFloatLiteral(text);
+    }
+
+    if (failures > 0)
+    {
+        fprintf(stderr, "%d numeric literal checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
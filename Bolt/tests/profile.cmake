@@ -0,0 +1,37 @@
+include("${CMAKE_CURRENT_LIST_DIR}/native.cmake")
+
+find_native_toolchain("${WORK_DIR}" reason)
+
+if(reason)
+    message("${reason}, skipping profile test")
+    return()
+endif()
+
+set(profile "${WORK_DIR}/program.profile")
+file(REMOVE "${profile}")
+
+compile_boltc("${PROGRAM}" "${WORK_DIR}/generate.s" --profile-generate "${profile}")
+link_native("${WORK_DIR}/generate.s" "${WORK_DIR}/generate")
+run_native("${WORK_DIR}/generate" "${WORK_DIR}")
+
+if(NOT EXISTS "${profile}")
+    message(FATAL_ERROR "Instrumented program did not write ${profile}")
+endif()
+
+file(SIZE "${profile}" profileBytes)
+
+if(profileBytes LESS 12)
+    message(FATAL_ERROR "Instrumented program wrote a truncated profile of ${profileBytes} bytes")
+endif()
+
+compile_boltc("${PROGRAM}" "${WORK_DIR}/plain.s")
+compile_boltc("${PROGRAM}" "${WORK_DIR}/use.s" --profile-use "${profile}")
+file(READ "${WORK_DIR}/plain.s" plain)
+file(READ "${WORK_DIR}/use.s" use)
+
+if(plain STREQUAL use)
+    message(FATAL_ERROR "--profile-use ${profile} did not change the emitted code")
+endif()
+
+link_native("${WORK_DIR}/use.s" "${WORK_DIR}/use")
+run_native("${WORK_DIR}/use" "${WORK_DIR}")
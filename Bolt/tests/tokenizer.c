@@ -0,0 +1,203 @@
+#include <tokenizer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *streamSource = "int main()\n"
+                                  "{\n"
+                                  "    // comment\n"
+                                  "    x += 0x1F; /* two\n"
+                                  "    lines */ y <<= .5 != \"text\";\n"
+                                  "    return !a && b || c >= -1.5e3f;\n"
+                                  "}\n";
+
+static const struct
+{
+    TokenType type;
+    uint32_t line;
+} streamTokens[] = {
+    {TOKEN_TYPE_INT, 1},
+    {TOKEN_TYPE_IDENTIFIER, 1},
+    {TOKEN_TYPE_LEFT_PAREN, 1},
+    {TOKEN_TYPE_RIGHT_PAREN, 1},
+    {TOKEN_TYPE_LEFT_BRACE, 2},
+    {TOKEN_TYPE_IDENTIFIER, 4},
+    {TOKEN_TYPE_ADD_AND_ASSIGN, 4},
+    {TOKEN_TYPE_INT_LITERAL, 4},
+    {TOKEN_TYPE_SEMICOLON, 4},
+    {TOKEN_TYPE_IDENTIFIER, 5},
+    {TOKEN_TYPE_LEFT_SHIFT, 5},
+    {TOKEN_TYPE_EQUAL, 5},
+    {TOKEN_TYPE_FLOAT_LITERAL, 5},
+    {TOKEN_TYPE_NOT_EQUAL, 5},
+    {TOKEN_TYPE_STRING_LITERAL, 5},
+    {TOKEN_TYPE_SEMICOLON, 5},
+    {TOKEN_TYPE_RETURN, 6},
+    {TOKEN_TYPE_LOGICAL_NOT, 6},
+    {TOKEN_TYPE_IDENTIFIER, 6},
+    {TOKEN_TYPE_LOGICAL_AND, 6},
+    {TOKEN_TYPE_IDENTIFIER, 6},
+    {TOKEN_TYPE_LOGICAL_OR, 6},
+    {TOKEN_TYPE_IDENTIFIER, 6},
+    {TOKEN_TYPE_GREATER_EQUAL, 6},
+    {TOKEN_TYPE_MINUS, 6},
+    {TOKEN_TYPE_FLOAT_LITERAL, 6},
+    {TOKEN_TYPE_SEMICOLON, 6},
+    {TOKEN_TYPE_RIGHT_BRACE, 7},
+    {TOKEN_TYPE_EOF, 8},
+};
+
+static const struct
+{
+    const char *text;
+    TokenType type;
+} keywordTokens[] = {
+    {"auto", TOKEN_TYPE_AUTO},
+    {"break", TOKEN_TYPE_BREAK},
+    {"case", TOKEN_TYPE_CASE},
+    {"char", TOKEN_TYPE_CHAR},
+    {"const", TOKEN_TYPE_CONST},
+    {"continue", TOKEN_TYPE_CONTINUE},
+    {"default", TOKEN_TYPE_DEFAULT},
+    {"do", TOKEN_TYPE_DO},
+    {"double", TOKEN_TYPE_DOUBLE},
+    {"else", TOKEN_TYPE_ELSE},
+    {"enum", TOKEN_TYPE_ENUM},
+    {"extern", TOKEN_TYPE_EXTERN},
+    {"float", TOKEN_TYPE_FLOAT},
+    {"for", TOKEN_TYPE_FOR},
+    {"goto", TOKEN_TYPE_GOTO},
+    {"if", TOKEN_TYPE_IF},
+    {"inline", TOKEN_TYPE_INLINE},
+    {"int", TOKEN_TYPE_INT},
+    {"long", TOKEN_TYPE_LONG},
+    {"register", TOKEN_TYPE_REGISTER},
+    {"return", TOKEN_TYPE_RETURN},
+    {"short", TOKEN_TYPE_SHORT},
+    {"signed", TOKEN_TYPE_SIGNED},
+    {"sizeof", TOKEN_TYPE_SIZEOF},
+    {"static", TOKEN_TYPE_STATIC},
+    {"struct", TOKEN_TYPE_STRUCT},
+    {"switch", TOKEN_TYPE_SWITCH},
+    {"typedef", TOKEN_TYPE_TYPEDEF},
+    {"union", TOKEN_TYPE_UNION},
+    {"unsigned", TOKEN_TYPE_UNSIGNED},
+    {"void", TOKEN_TYPE_VOID},
+    {"volatile", TOKEN_TYPE_VOLATILE},
+    {"while", TOKEN_TYPE_WHILE},
+    {"a", TOKEN_TYPE_IDENTIFIER},
+    {"d", TOKEN_TYPE_IDENTIFIER},
+    {"aut", TOKEN_TYPE_IDENTIFIER},
+    {"autos", TOKEN_TYPE_IDENTIFIER},
+    {"Auto", TOKEN_TYPE_IDENTIFIER},
+    {"do_", TOKEN_TYPE_IDENTIFIER},
+    {"ifx", TOKEN_TYPE_IDENTIFIER},
+    {"sizeofx", TOKEN_TYPE_IDENTIFIER},
+    {"unsigned1", TOKEN_TYPE_IDENTIFIER},
+    {"continues", TOKEN_TYPE_IDENTIFIER},
+    {"whilf", TOKEN_TYPE_IDENTIFIER},
+};
+
+static int failures = 0;
+
+static void expect(bool condition, const char *message, const char *source)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "%s: %s\n", message, source);
+        failures++;
+    }
+}
+
+static void testTokenStream(void)
+{
+    Tokenizer tokenizer;
+    initTokenizer(&tokenizer);
+    setTokenizerSourceCode(&tokenizer, streamSource);
+
+    expect(scanTokens(&tokenizer) == SCANNER_STATUS_OK, "scan failed", streamSource);
+    expect(tokenizer.tokens.count == sizeof(streamTokens) / sizeof(streamTokens[0]), "token count differs",
+           streamSource);
+
+    for (size_t i = 0; i < tokenizer.tokens.count && i < sizeof(streamTokens) / sizeof(streamTokens[0]); i++)
+    {
+        expect(tokenizer.tokens.tokens[i].type == streamTokens[i].type, "token type differs",
+               tokenizer.tokens.tokens[i].lexeme);
+        expect(tokenizer.tokens.tokens[i].line == streamTokens[i].line, "token line differs",
+               tokenizer.tokens.tokens[i].lexeme);
+    }
+
+    freeTokenizer(&tokenizer);
+}
+
+static void testKeywords(void)
+{
+    for (size_t i = 0; i < sizeof(keywordTokens) / sizeof(keywordTokens[0]); i++)
+    {
+        Tokenizer tokenizer;
+        initTokenizer(&tokenizer);
+        setTokenizerSourceCode(&tokenizer, keywordTokens[i].text);
+
+        expect(scanTokens(&tokenizer) == SCANNER_STATUS_OK && tokenizer.tokens.count == 2 &&
+                   tokenizer.tokens.tokens[0].type == keywordTokens[i].type,
+               "keyword classified wrongly", keywordTokens[i].text);
+
+        freeTokenizer(&tokenizer);
+    }
+}
+
+static void testSingleTokens(void)
+{
+    Tokenizer all;
+    Tokenizer single;
+    initTokenizer(&all);
+    initTokenizer(&single);
+    setTokenizerSourceCode(&all, streamSource);
+    setTokenizerSourceCode(&single, streamSource);
+    scanTokens(&all);
+
+    for (size_t i = 0; i + 1 < all.tokens.count; i++)
+    {
+        expect(scanToken(&single) == SCANNER_STATUS_OK, "single scan failed", all.tokens.tokens[i].lexeme);
+        expect(single.tokens.count == i + 1, "single scan did not add exactly one token", all.tokens.tokens[i].lexeme);
+
+        if (single.tokens.count == i + 1)
+        {
+            expect(single.tokens.tokens[i].type == all.tokens.tokens[i].type &&
+                       single.tokens.tokens[i].line == all.tokens.tokens[i].line,
+                   "single scan differs from bulk scan", all.tokens.tokens[i].lexeme);
+        }
+    }
+
+    freeTokenizer(&all);
+    freeTokenizer(&single);
+}
+
+static void testUnterminatedComment(void)
+{
+    const char *source = "int /* open\n";
+    Tokenizer tokenizer;
+    initTokenizer(&tokenizer);
+    setTokenizerSourceCode(&tokenizer, source);
+
+    expect(scanTokens(&tokenizer) == SCANNER_STATUS_ERROR_UNTERMINATED_COMMENT && tokenizer.errorLine == 1,
+           "unterminated comment not reported", source);
+
+    freeTokenizer(&tokenizer);
+}
+
+int main(void)
+{
+    testTokenStream();
+    testKeywords();
+    testSingleTokens();
+    testUnterminatedComment();
+
+    if (failures > 0)
+    {
+        fprintf(stderr, "%d tokenizer checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}